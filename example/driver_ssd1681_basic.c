@@ -37,37 +37,65 @@
 #include "driver_ssd1681_basic.h"
 
 static ssd1681_handle_t gs_handle;        /**< ssd1681 handle */
-static uint8_t gs_lut[153] = {            /**< lut */
-    0x80, 0x48, 0x40, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x40, 0x48, 0x80, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x80, 0x48, 0x40, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x40, 0x48, 0x80, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0xA, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x8, 0x1, 0x0, 0x8, 0x1, 0x0, 0x2,
-    0xA, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x0, 0x0, 0x0,
+static const ssd1681_init_record_t gs_init_table[] = {   /**< init table */
+    {0x12, 0, {0}},                                                                                     /* software reset */
+    {0x01, 3, {(SSD1681_BASIC_DEFAULT_DRIVER_OUTPUT_MUX >> 0) & 0xFF,
+               (SSD1681_BASIC_DEFAULT_DRIVER_OUTPUT_MUX >> 8) & 0x01,
+               (SSD1681_BASIC_DEFAULT_DRIVER_OUTPUT_GD << 2) |
+               (SSD1681_BASIC_DEFAULT_DRIVER_OUTPUT_SM << 1) |
+               (SSD1681_BASIC_DEFAULT_DRIVER_OUTPUT_TB << 0)}},                                         /* driver output */
+    {0x11, 1, {(SSD1681_BASIC_DEFAULT_ADDRESS_MODE << 0) |
+               (SSD1681_BASIC_DEFAULT_ADDRESS_DIRECTION << 2)}},                                        /* data entry mode */
+    {0x18, 1, {SSD1681_BASIC_DEFAULT_TEMPERATURE_SENSOR}},                                              /* temperature sensor */
+    {0x3C, 1, {(SSD1681_BASIC_DEFAULT_VBD << 6) | (SSD1681_BASIC_DEFAULT_VBD_FIX_LEVEL << 4) |
+               (SSD1681_BASIC_DEFAULT_GS_TRANSITION << 2) |
+               (SSD1681_BASIC_DEFAULT_VBD_TRANSITION << 0)}},                                           /* border waveform */
+    {0x44, 2, {SSD1681_BASIC_DEFAULT_RAM_X_START, SSD1681_BASIC_DEFAULT_RAM_X_END}},                    /* ram x */
+    {0x45, 4, {(SSD1681_BASIC_DEFAULT_RAM_Y_START >> 0) & 0xFF,
+               (SSD1681_BASIC_DEFAULT_RAM_Y_START >> 8) & 0x01,
+               (SSD1681_BASIC_DEFAULT_RAM_Y_END >> 0) & 0xFF,
+               (SSD1681_BASIC_DEFAULT_RAM_Y_END >> 8) & 0x01}},                                         /* ram y */
+    {0x4E, 1, {SSD1681_BASIC_DEFAULT_RAM_X_ADDRESS_COUNTER}},                                           /* ram x address counter */
+    {0x4F, 2, {(SSD1681_BASIC_DEFAULT_RAM_Y_ADDRESS_COUNTER >> 0) & 0xFF,
+               (SSD1681_BASIC_DEFAULT_RAM_Y_ADDRESS_COUNTER >> 8) & 0x01}},                             /* ram y address counter */
+    {0x21, 1, {(SSD1681_BASIC_DEFAULT_DISPLAY_CONTROL_RED << 4) |
+               (SSD1681_BASIC_DEFAULT_DISPLAY_CONTROL_BLACK << 0)}},                                    /* display update control */
+    {0x22, 1, {SSD1681_BASIC_DEFAULT_DISPLAY_SEQUENCE}},                                                /* display sequence */
+    {0x29, 1, {SSD1681_BASIC_DEFAULT_VCOM_SENSE_DURATION}},                                             /* vcom sense duration */
+    {0x28, 0, {0}},                                                                                     /* enter the vcom sense */
+    {0x2B, 2, {0x04, 0x63}},                                                                            /* vcom control reg */
+    {0x3F, 1, {SSD1681_BASIC_DEFAULT_END_OPT}},                                                         /* end option */
+    {0x03, 1, {SSD1681_BASIC_DEFAULT_GATE_DRIVING_VOLTAGE}},                                            /* gate driving voltage */
+    {0x04, 3, {SSD1681_BASIC_DEFAULT_VSH1, SSD1681_BASIC_DEFAULT_VSH2, SSD1681_BASIC_DEFAULT_VSL}},     /* source driving voltage */
+    {0x2C, 1, {SSD1681_BASIC_DEFAULT_VCOM}},                                                            /* vcom */
+    {0x46, 1, {(SSD1681_BASIC_DEFAULT_AUTO_RED_STEP_HEIGHT << 4) |
+               (SSD1681_BASIC_DEFAULT_AUTO_RED_STEP_WIDTH << 0)}},                                      /* auto write red ram */
+    {0x47, 1, {(SSD1681_BASIC_DEFAULT_AUTO_BLACK_STEP_HEIGHT << 4) |
+               (SSD1681_BASIC_DEFAULT_AUTO_BLACK_STEP_WIDTH << 0)}},                                    /* auto write black ram */
+    {0x14, 1, {(SSD1681_BASIC_DEFAULT_COOL_DOWN_DURATION << 4) |
+               (SSD1681_BASIC_DEFAULT_COOL_DOWN_LOOP_NUM << 0)}},                                       /* hv ready detection */
+    {0x15, 1, {SSD1681_BASIC_DEFAULT_VCI}},                                                             /* vci detection */
+    {0x0C, 4, {0x80 | SSD1681_BASIC_DEFAULT_PHASE1, 0x80 | SSD1681_BASIC_DEFAULT_PHASE2,
+               0x80 | SSD1681_BASIC_DEFAULT_PHASE3, SSD1681_BASIC_DEFAULT_DURATION}},               /* booster soft start */
+    {0x10, 1, {SSD1681_BASIC_DEFAULT_MODE}},                                                            /* mode */
+};
+static ssd1681_lut_band_t gs_lut_table[2] = {             /**< lut band table */
+    {SSD1681_BASIC_DEFAULT_LUT_COLD_MIN, NULL, 0},
+    {SSD1681_BASIC_DEFAULT_LUT_WARM_MIN, NULL, 0},
 };
 
 /**
- * @brief  basic example init
- * @return status code
- *         - 0 success
- *         - 1 init failed
- * @note   none
+ * @brief     open the basic example
+ * @param[in] attach 1 is attach to the running chip, 0 is init with the reset
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      none
  */
-uint8_t ssd1681_basic_init(void)
+static uint8_t a_ssd1681_basic_open(uint8_t attach)
 {
     uint8_t res;
+    int16_t temperature;
 
     /* link functions */
     DRIVER_SSD1681_LINK_INIT(&gs_handle, ssd1681_handle_t);
@@ -84,317 +112,515 @@ uint8_t ssd1681_basic_init(void)
     DRIVER_SSD1681_LINK_BUSY_GPIO_INIT(&gs_handle, ssd1681_interface_busy_gpio_init);
     DRIVER_SSD1681_LINK_BUSY_GPIO_DEINIT(&gs_handle, ssd1681_interface_busy_gpio_deinit);
     DRIVER_SSD1681_LINK_BUSY_GPIO_READ(&gs_handle, ssd1681_interface_busy_gpio_read);
+    DRIVER_SSD1681_LINK_BUSY_GPIO_WAIT(&gs_handle, ssd1681_interface_busy_gpio_wait);
     DRIVER_SSD1681_LINK_DELAY_MS(&gs_handle, ssd1681_interface_delay_ms);
     DRIVER_SSD1681_LINK_DEBUG_PRINT(&gs_handle, ssd1681_interface_debug_print);
+    DRIVER_SSD1681_LINK_SPI_WRITE_CMD_DMA(&gs_handle, ssd1681_interface_spi_write_cmd_dma);
 
-    /* init */
-    res = ssd1681_init(&gs_handle);
+    /* set the interface */
+    res = ssd1681_set_interface(&gs_handle, SSD1681_BASIC_DEFAULT_INTERFACE);
     if (res != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: init failed.\n");
-
+        ssd1681_interface_debug_print("ssd1681: set interface failed.\n");
+        
         return 1;
     }
-
-    /* reset the chip */
-    res = ssd1681_software_reset(&gs_handle);
+    
+    /* set the busy mode */
+    res = ssd1681_set_busy_mode(&gs_handle, SSD1681_BASIC_DEFAULT_BUSY_MODE);
     if (res != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: software reset failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
-
+        ssd1681_interface_debug_print("ssd1681: set busy mode failed.\n");
+        
         return 1;
     }
-
-    /* set the default driver output */
-    res = ssd1681_set_driver_output(&gs_handle, SSD1681_BASIC_DEFAULT_DRIVER_OUTPUT_MUX,
-                                    SSD1681_BASIC_DEFAULT_DRIVER_OUTPUT_GD,
-                                    SSD1681_BASIC_DEFAULT_DRIVER_OUTPUT_SM,
-                                    SSD1681_BASIC_DEFAULT_DRIVER_OUTPUT_TB);
+    
+    /* set the spi frequency */
+    res = ssd1681_interface_spi_set_frequency(SSD1681_BASIC_DEFAULT_SPI_FREQUENCY);
     if (res != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set the driver output failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
-
+        ssd1681_interface_debug_print("ssd1681: set spi frequency failed.\n");
+        
         return 1;
     }
+    
+    if (attach != 0)
+    {
+        /* attach */
+        res = ssd1681_attach(&gs_handle);
+        if (res != 0)
+        {
+            ssd1681_interface_debug_print("ssd1681: attach failed.\n");
 
-    /* set the default data entry mode */
-    res = ssd1681_set_data_entry_mode(&gs_handle, SSD1681_BASIC_DEFAULT_ADDRESS_MODE, SSD1681_BASIC_DEFAULT_ADDRESS_DIRECTION);
-    if (res != 0)
+            return 1;
+        }
+    }
+    else
     {
-        ssd1681_interface_debug_print("ssd1681: set data entry mode failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
+        /* init */
+        res = ssd1681_init(&gs_handle);
+        if (res != 0)
+        {
+            ssd1681_interface_debug_print("ssd1681: init failed.\n");
 
-        return 1;
+            return 1;
+        }
+
+        /* run the init table */
+        res = ssd1681_run_init_table(&gs_handle, gs_init_table, sizeof(gs_init_table) / sizeof(gs_init_table[0]));
+        if (res != 0)
+        {
+            ssd1681_interface_debug_print("ssd1681: run init table failed.\n");
+            (void)ssd1681_deinit(&gs_handle);
+
+            return 1;
+        }
     }
 
-    /* set the default temperature sensor */
-    res = ssd1681_set_temperature_sensor(&gs_handle, SSD1681_BASIC_DEFAULT_TEMPERATURE_SENSOR);
+    /* get the cold band waveform */
+    res = ssd1681_get_waveform(SSD1681_BASIC_DEFAULT_LUT_COLD_WAVEFORM, &gs_lut_table[0].lut, &gs_lut_table[0].len);
     if (res != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set temperature sensor failed.\n");
+        ssd1681_interface_debug_print("ssd1681: get waveform failed.\n");
         (void)ssd1681_deinit(&gs_handle);
 
         return 1;
     }
 
-    /* set the default border waveform */
-    res = ssd1681_set_border_waveform(&gs_handle, SSD1681_BASIC_DEFAULT_VBD, SSD1681_BASIC_DEFAULT_VBD_FIX_LEVEL,
-                                      SSD1681_BASIC_DEFAULT_GS_TRANSITION, SSD1681_BASIC_DEFAULT_VBD_TRANSITION);
+    /* get the warm band waveform */
+    res = ssd1681_get_waveform(SSD1681_BASIC_DEFAULT_LUT_WARM_WAVEFORM, &gs_lut_table[1].lut, &gs_lut_table[1].len);
     if (res != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set border waveform failed.\n");
+        ssd1681_interface_debug_print("ssd1681: get waveform failed.\n");
         (void)ssd1681_deinit(&gs_handle);
 
         return 1;
     }
 
-    /* set the default x range */
-    res = ssd1681_set_ram_x(&gs_handle, SSD1681_BASIC_DEFAULT_RAM_X_START, SSD1681_BASIC_DEFAULT_RAM_X_END);
+    /* set the lut table */
+    res = ssd1681_set_lut_table(&gs_handle, gs_lut_table, 2);
     if (res != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set ram x failed.\n");
+        ssd1681_interface_debug_print("ssd1681: set lut table failed.\n");
         (void)ssd1681_deinit(&gs_handle);
 
         return 1;
     }
 
-    /* set the default y range */
-    res = ssd1681_set_ram_y(&gs_handle, SSD1681_BASIC_DEFAULT_RAM_Y_START, SSD1681_BASIC_DEFAULT_RAM_Y_END);
-    if (res != 0)
+    /* select the lut by the temperature, the attached chip keeps its lut */
+    if (attach == 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set ram y failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
+        res = ssd1681_select_lut_by_sensor(&gs_handle, &temperature);
+        if (res != 0)
+        {
+            ssd1681_interface_debug_print("ssd1681: select lut by sensor failed.\n");
+            (void)ssd1681_deinit(&gs_handle);
 
-        return 1;
+            return 1;
+        }
     }
 
-    /* set the default ram x address counter */
-    res = ssd1681_set_ram_x_address_counter(&gs_handle, SSD1681_BASIC_DEFAULT_RAM_X_ADDRESS_COUNTER);
+    /* set the default power sleep mode */
+    res = ssd1681_set_power_sleep_mode(&gs_handle, SSD1681_BASIC_DEFAULT_POWER_SLEEP_MODE);
     if (res != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set ram x address counter failed.\n");
+        ssd1681_interface_debug_print("ssd1681: set power sleep mode failed.\n");
         (void)ssd1681_deinit(&gs_handle);
 
         return 1;
     }
 
-    /* set the default ram y address counter */
-    res = ssd1681_set_ram_y_address_counter(&gs_handle, SSD1681_BASIC_DEFAULT_RAM_Y_ADDRESS_COUNTER);
+    /* set the default power idle time */
+    res = ssd1681_set_power_idle_time(&gs_handle, SSD1681_BASIC_DEFAULT_POWER_IDLE_TIME);
     if (res != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set ram y address counter failed.\n");
+        ssd1681_interface_debug_print("ssd1681: set power idle time failed.\n");
         (void)ssd1681_deinit(&gs_handle);
 
         return 1;
     }
 
-    /* set the default display update control mode */
-    res = ssd1681_set_display_update_control(&gs_handle, SSD1681_BASIC_DEFAULT_DISPLAY_CONTROL_RED, SSD1681_BASIC_DEFAULT_DISPLAY_CONTROL_BLACK);
+    /* set the default power manager */
+    res = ssd1681_set_power_manager(&gs_handle, SSD1681_BASIC_DEFAULT_POWER_MANAGER);
     if (res != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set display update control failed.\n");
+        ssd1681_interface_debug_print("ssd1681: set power manager failed.\n");
         (void)ssd1681_deinit(&gs_handle);
 
         return 1;
     }
 
-    /* set the default sequence */
-    res = ssd1681_set_display_sequence(&gs_handle, SSD1681_BASIC_DEFAULT_DISPLAY_SEQUENCE);
-    if (res != 0)
+    if (attach != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set display sequence failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
+        /* read the black back */
+        res = ssd1681_gram_read_back(&gs_handle, SSD1681_COLOR_BLACK);
+        if (res != 0)
+        {
+            ssd1681_interface_debug_print("ssd1681: gram read back failed.\n");
+            (void)ssd1681_deinit(&gs_handle);
 
-        return 1;
-    }
+            return 1;
+        }
+#if (SSD1681_MONOCHROME == 0)
 
-    /* set the default vcom sense duration */
-    res = ssd1681_set_vcom_sense_duration(&gs_handle, SSD1681_BASIC_DEFAULT_VCOM_SENSE_DURATION);
-    if (res != 0)
+        /* read the red back */
+        res = ssd1681_gram_read_back(&gs_handle, SSD1681_COLOR_RED);
+        if (res != 0)
+        {
+            ssd1681_interface_debug_print("ssd1681: gram read back failed.\n");
+            (void)ssd1681_deinit(&gs_handle);
+
+            return 1;
+        }
+#endif
+    }
+    else
     {
-        ssd1681_interface_debug_print("ssd1681: set vcom sense duration failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
+        /* clear the black */
+        res = ssd1681_gram_clear(&gs_handle, SSD1681_COLOR_BLACK);
+        if (res != 0)
+        {
+            ssd1681_interface_debug_print("ssd1681: clear failed.\n");
+            (void)ssd1681_deinit(&gs_handle);
 
-        return 1;
+            return 1;
+        }
+
+        /* clear the red */
+        res = ssd1681_gram_clear(&gs_handle, SSD1681_COLOR_RED);
+        if (res != 0)
+        {
+            ssd1681_interface_debug_print("ssd1681: clear failed.\n");
+            (void)ssd1681_deinit(&gs_handle);
+
+            return 1;
+        }
     }
 
-    /* enter the vcom sense */
-    res = ssd1681_set_enter_vcom_sense(&gs_handle);
-    if (res != 0)
-    {
-        ssd1681_interface_debug_print("ssd1681: set enter vcom sense failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
+    return 0;
+}
+
+/**
+ * @brief  basic example init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+uint8_t ssd1681_basic_init(void)
+{
+    return a_ssd1681_basic_open(0);
+}
+
+/**
+ * @brief  basic example attach to a running chip without the reset
+ * @return status code
+ *         - 0 success
+ *         - 1 attach failed
+ * @note   the gram is read back from the chip, so ssd1681_basic_clear skips the refresh
+ *         when the panel is already clear
+ */
+uint8_t ssd1681_basic_attach(void)
+{
+    return a_ssd1681_basic_open(1);
+}
 
+/**
+ * @brief  basic example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t ssd1681_basic_deinit(void)
+{
+    /* deinit ssd1681 */
+    if (ssd1681_deinit(&gs_handle) != 0)
+    {
         return 1;
     }
-
-    /* set the vcom control reg */
-    res = ssd1681_set_vcom_control_reg(&gs_handle);
-    if (res != 0)
+    else
     {
-        ssd1681_interface_debug_print("ssd1681: set vcom control reg failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
+        return 0;
+    }
+}
 
+/**
+ * @brief     write and read back the first 8 rows of the black ram
+ * @param[in] *buf pointer to a written data buffer
+ * @param[in] check 1 is read back and compare, 0 is only write
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_ssd1681_basic_ram_check(uint8_t *buf, uint8_t check)
+{
+    uint16_t i;
+    uint8_t read_buf[201];
+    
+    /* write the black ram */
+    if (ssd1681_set_ram_x_address_counter(&gs_handle, SSD1681_BASIC_DEFAULT_RAM_X_ADDRESS_COUNTER) != 0)
+    {
         return 1;
     }
-
-    /* set the lut register */
-    res = ssd1681_set_lut_register(&gs_handle, gs_lut, 153);
-    if (res != 0)
+    if (ssd1681_set_ram_y_address_counter(&gs_handle, SSD1681_BASIC_DEFAULT_RAM_Y_ADDRESS_COUNTER) != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set lut register failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
-
         return 1;
     }
-
-    /* set the default end option */
-    res = ssd1681_set_end_option(&gs_handle, SSD1681_BASIC_DEFAULT_END_OPT);
-    if (res != 0)
+    if (ssd1681_set_black_ram(&gs_handle) != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set end option failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
-
         return 1;
     }
-
-    /* set the default gate driving voltage */
-    res = ssd1681_set_gate_driving_voltage(&gs_handle, SSD1681_BASIC_DEFAULT_GATE_DRIVING_VOLTAGE);
-    if (res != 0)
+    if (ssd1681_write_data(&gs_handle, buf, 200) != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set gate driving voltage failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
-
         return 1;
     }
-
-    /* set the default source driving voltage */
-    res = ssd1681_set_source_driving_voltage(&gs_handle, SSD1681_BASIC_DEFAULT_VSH1, SSD1681_BASIC_DEFAULT_VSH2, SSD1681_BASIC_DEFAULT_VSL);
-    if (res != 0)
+    if (check == 0)
+    {
+        return 0;
+    }
+    
+    /* read the black ram back */
+    if (ssd1681_set_ram_x_address_counter(&gs_handle, SSD1681_BASIC_DEFAULT_RAM_X_ADDRESS_COUNTER) != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set source driving voltage failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
-
         return 1;
     }
-
-    /* set the default vcom */
-    res = ssd1681_set_vcom_register(&gs_handle, SSD1681_VCOM_NEGATIVE_0P8);
-    if (res != 0)
+    if (ssd1681_set_ram_y_address_counter(&gs_handle, SSD1681_BASIC_DEFAULT_RAM_Y_ADDRESS_COUNTER) != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set vcom register failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
-
         return 1;
     }
-
-    /* set the default auto write red ram */
-    res = ssd1681_set_auto_write_red_ram(&gs_handle, SSD1681_BASIC_DEFAULT_AUTO_RED_STEP_HEIGHT, SSD1681_BASIC_DEFAULT_AUTO_RED_STEP_WIDTH);
-    if (res != 0)
+    if (ssd1681_set_read_ram(&gs_handle, SSD1681_READ_RAM_BLACK) != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set auto write red ram failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
-
         return 1;
     }
-
-    /* set the default auto write black ram */
-    res = ssd1681_set_auto_write_black_ram(&gs_handle, SSD1681_BASIC_DEFAULT_AUTO_BLACK_STEP_HEIGHT, SSD1681_BASIC_DEFAULT_AUTO_BLACK_STEP_WIDTH);
-    if (res != 0)
+    if (ssd1681_get_ram(&gs_handle) != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set auto write black ram failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
-
         return 1;
     }
-
-    /* set the default hv ready detection */
-    res = ssd1681_set_hv_ready_detection(&gs_handle, SSD1681_BASIC_DEFAULT_COOL_DOWN_DURATION, SSD1681_BASIC_DEFAULT_COOL_DOWN_LOOP_NUM);
-    if (res != 0)
+    if (ssd1681_read_data(&gs_handle, read_buf, 201) != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set hv ready detection failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
-
         return 1;
     }
-
-    /* set the default vci detection */
-    res = ssd1681_set_vci_detection(&gs_handle, SSD1681_BASIC_DEFAULT_VCI);
-    if (res != 0)
+    
+    /* the first byte is dummy */
+    for (i = 0; i < 200; i++)
     {
-        ssd1681_interface_debug_print("ssd1681: set vci detection failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
+        if (read_buf[i + 1] != buf[i])
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
 
+/**
+ * @brief      basic example calibrate the spi clock
+ * @param[out] *freq pointer to a spi clock frequency buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 calibrate failed
+ * @note       the clock is raised step by step and checked by reading the black ram back,
+ *             the first 8 rows of the black ram are restored from the gram when it is done
+ */
+uint8_t ssd1681_basic_spi_calibrate(uint32_t *freq)
+{
+    uint8_t buf[200];
+    uint8_t round;
+    uint16_t i;
+    uint32_t f;
+    uint32_t pass;
+    
+    /* raise the clock until the read back fails */
+    pass = 0;
+    for (f = SSD1681_BASIC_DEFAULT_SPI_FREQUENCY; f <= SSD1681_BASIC_SPI_CALIBRATION_MAX; f += SSD1681_BASIC_SPI_CALIBRATION_STEP)
+    {
+        if (ssd1681_interface_spi_set_frequency(f) != 0)
+        {
+            break;
+        }
+        for (round = 0; round < SSD1681_BASIC_SPI_CALIBRATION_ROUND; round++)
+        {
+            for (i = 0; i < 200; i++)
+            {
+                buf[i] = (uint8_t)((i * 37 + round * 11) ^ 0xA5);
+            }
+            if (a_ssd1681_basic_ram_check(buf, 1) != 0)
+            {
+                break;
+            }
+        }
+        if (round != SSD1681_BASIC_SPI_CALIBRATION_ROUND)
+        {
+            break;
+        }
+        pass = f;
+    }
+    
+    /* keep a margin */
+    f = (uint32_t)(((uint64_t)pass * SSD1681_BASIC_SPI_CALIBRATION_MARGIN) / 100);
+    if (f < SSD1681_BASIC_DEFAULT_SPI_FREQUENCY)
+    {
+        f = SSD1681_BASIC_DEFAULT_SPI_FREQUENCY;
+    }
+    if (ssd1681_interface_spi_set_frequency(f) != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: set spi frequency failed.\n");
+        
         return 1;
     }
-
-    /* set the default booster soft start param */
-    res = ssd1681_set_booster_soft_start(&gs_handle,
-                                        (uint8_t)(SSD1681_BASIC_DEFAULT_PHASE1),
-                                        (uint8_t)(SSD1681_BASIC_DEFAULT_PHASE2),
-                                        (uint8_t)(SSD1681_BASIC_DEFAULT_PHASE3),
-                                        (uint8_t)(SSD1681_BASIC_DEFAULT_DURATION));
-    if (res != 0)
+    if (pass == 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set booster soft start failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
-
+        ssd1681_interface_debug_print("ssd1681: spi read back check failed.\n");
+        
         return 1;
     }
-
-    /* set the default mode */
-    res = ssd1681_set_mode(&gs_handle, SSD1681_BASIC_DEFAULT_MODE);
-    if (res != 0)
+    
+    /* restore the black ram */
+    if (a_ssd1681_basic_ram_check(&gs_handle.black_gram[0][0], 0) != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set mode failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
-
+        ssd1681_interface_debug_print("ssd1681: restore black ram failed.\n");
+        
         return 1;
     }
+    
+    /* get the frequency */
+    if (ssd1681_interface_spi_get_frequency(freq) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
 
-    /* clear the black */
-    res = ssd1681_gram_clear(&gs_handle, SSD1681_COLOR_BLACK);
-    if (res != 0)
+/**
+ * @brief  basic example update the black gram with the dma
+ * @return status code
+ *         - 0 success
+ *         - 1 update failed
+ * @note   call ssd1681_basic_dma_irq_handler in the dma irq and ssd1681_basic_refresh after the dma is done
+ */
+uint8_t ssd1681_basic_gram_update_dma(void)
+{
+    /* start the dma */
+    if (ssd1681_gram_update_dma(&gs_handle, SSD1681_COLOR_BLACK) != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: clear failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
+        return 1;
+    }
+    
+    return 0;
+}
 
+/**
+ * @brief     basic example dma irq handler
+ * @param[in] res transfer result
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+uint8_t ssd1681_basic_dma_irq_handler(uint8_t res)
+{
+    /* run the irq handler */
+    if (ssd1681_dma_irq_handler(&gs_handle, res) != 0)
+    {
         return 1;
     }
+    
+    return 0;
+}
 
-    /* clear the red */
-    res = ssd1681_gram_clear(&gs_handle, SSD1681_COLOR_RED);
-    if (res != 0)
+/**
+ * @brief  basic example refresh the display
+ * @return status code
+ *         - 0 success
+ *         - 1 refresh failed
+ * @note   none
+ */
+uint8_t ssd1681_basic_refresh(void)
+{
+    /* refresh */
+    if (ssd1681_gram_activate(&gs_handle) != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: clear failed.\n");
-        (void)ssd1681_deinit(&gs_handle);
+        return 1;
+    }
+    
+    return 0;
+}
 
+/**
+ * @brief      basic example select the lut by the temperature
+ * @param[out] *temperature pointer to a temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 select failed
+ * @note       none
+ */
+uint8_t ssd1681_basic_select_lut(int16_t *temperature)
+{
+    /* select the lut */
+    if (ssd1681_select_lut_by_sensor(&gs_handle, temperature) != 0)
+    {
         return 1;
     }
+    
+    return 0;
+}
 
+/**
+ * @brief  basic example enter the deep sleep
+ * @return status code
+ *         - 0 success
+ *         - 1 sleep failed
+ * @note   call ssd1681_basic_resume before the next update
+ */
+uint8_t ssd1681_basic_sleep(void)
+{
+    /* enter the deep sleep */
+    if (ssd1681_set_mode(&gs_handle, SSD1681_MODE_DEEP_SLEEP_1) != 0)
+    {
+        return 1;
+    }
+    
     return 0;
 }
 
 /**
- * @brief  basic example deinit
+ * @brief  basic example resume from the deep sleep
  * @return status code
  *         - 0 success
- *         - 1 deinit failed
+ *         - 1 resume failed
  * @note   none
  */
-uint8_t ssd1681_basic_deinit(void)
+uint8_t ssd1681_basic_resume(void)
 {
-    /* deinit ssd1681 */
-    if (ssd1681_deinit(&gs_handle) != 0)
+    /* resume */
+    if (ssd1681_resume(&gs_handle) != 0)
     {
         return 1;
     }
-    else
+    
+    return 0;
+}
+
+/**
+ * @brief     basic example run the power manager
+ * @param[in] ms time passed since the last call in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 power process failed
+ * @note      call it periodically when the power manager is enabled
+ */
+uint8_t ssd1681_basic_power_process(uint32_t ms)
+{
+    /* run the power manager */
+    if (ssd1681_power_process(&gs_handle, ms) != 0)
     {
-        return 0;
+        return 1;
     }
+    
+    return 0;
 }
 
 /**
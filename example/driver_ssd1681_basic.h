@@ -53,6 +53,8 @@ extern "C"{
 /**
  * @brief ssd1681 basic example default definition
  */
+#define SSD1681_BASIC_DEFAULT_INTERFACE                     SSD1681_INTERFACE_4_WIRE                                       /**< 4-wire interface */
+#define SSD1681_BASIC_DEFAULT_BUSY_MODE                     SSD1681_BUSY_MODE_POLL                                         /**< poll the busy gpio */
 #define SSD1681_BASIC_DEFAULT_DRIVER_OUTPUT_MUX             0xC7                                                           /**< 200 - 1*/
 #define SSD1681_BASIC_DEFAULT_DRIVER_OUTPUT_GD              SSD1681_BOOL_FALSE                                             /**< disable gd */
 #define SSD1681_BASIC_DEFAULT_DRIVER_OUTPUT_SM              SSD1681_BOOL_FALSE                                             /**< disable sm */
@@ -94,6 +96,22 @@ extern "C"{
                                                               | (SSD1681_PHASE_DURATION_40MS << 2) \
                                                               | (SSD1681_PHASE_DURATION_40MS << 0))                        /**< 10ms && 40ms && 40ms */
 #define SSD1681_BASIC_DEFAULT_MODE                          SSD1681_MODE_NORMAL                                            /**< normal mode */
+#define SSD1681_BASIC_DEFAULT_POWER_MANAGER                 SSD1681_BOOL_FALSE                                             /**< disable the power manager */
+#define SSD1681_BASIC_DEFAULT_POWER_IDLE_TIME               5000                                                           /**< 5000ms */
+#define SSD1681_BASIC_DEFAULT_POWER_SLEEP_MODE              SSD1681_MODE_DEEP_SLEEP_1                                      /**< deep sleep mode 1 */
+#define SSD1681_BASIC_DEFAULT_SPI_FREQUENCY                 1000000                                                        /**< 1MHz */
+#define SSD1681_BASIC_DEFAULT_LUT_COLD_MIN                  (-40)                                                          /**< -40C */
+#define SSD1681_BASIC_DEFAULT_LUT_WARM_MIN                  25                                                             /**< 25C */
+#define SSD1681_BASIC_DEFAULT_LUT_COLD_WAVEFORM             SSD1681_WAVEFORM_FULL                                          /**< full quality waveform */
+#define SSD1681_BASIC_DEFAULT_LUT_WARM_WAVEFORM             SSD1681_WAVEFORM_FAST                                          /**< fast full waveform */
+
+/**
+ * @brief ssd1681 basic example spi calibration definition
+ */
+#define SSD1681_BASIC_SPI_CALIBRATION_MAX                   20000000                                                       /**< 20MHz */
+#define SSD1681_BASIC_SPI_CALIBRATION_STEP                  1000000                                                        /**< 1MHz */
+#define SSD1681_BASIC_SPI_CALIBRATION_ROUND                 3                                                              /**< 3 rounds for each frequency */
+#define SSD1681_BASIC_SPI_CALIBRATION_MARGIN                80                                                             /**< 80% of the last passed frequency */
 
 /**
  * @brief  basic example init
@@ -104,6 +122,16 @@ extern "C"{
  */
 uint8_t ssd1681_basic_init(void);
 
+/**
+ * @brief  basic example attach to a running chip without the reset
+ * @return status code
+ *         - 0 success
+ *         - 1 attach failed
+ * @note   the gram is read back from the chip, so ssd1681_basic_clear skips the refresh
+ *         when the panel is already clear
+ */
+uint8_t ssd1681_basic_attach(void);
+
 /**
  * @brief  basic example deinit
  * @return status code
@@ -113,6 +141,83 @@ uint8_t ssd1681_basic_init(void);
  */
 uint8_t ssd1681_basic_deinit(void);
 
+/**
+ * @brief      basic example calibrate the spi clock
+ * @param[out] *freq pointer to a spi clock frequency buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 calibrate failed
+ * @note       the clock is raised step by step and checked by reading the black ram back,
+ *             the first 8 rows of the black ram are restored from the gram when it is done
+ */
+uint8_t ssd1681_basic_spi_calibrate(uint32_t *freq);
+
+/**
+ * @brief  basic example update the black gram with the dma
+ * @return status code
+ *         - 0 success
+ *         - 1 update failed
+ * @note   call ssd1681_basic_dma_irq_handler in the dma irq and ssd1681_basic_refresh after the dma is done
+ */
+uint8_t ssd1681_basic_gram_update_dma(void);
+
+/**
+ * @brief     basic example dma irq handler
+ * @param[in] res transfer result
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+uint8_t ssd1681_basic_dma_irq_handler(uint8_t res);
+
+/**
+ * @brief  basic example refresh the display
+ * @return status code
+ *         - 0 success
+ *         - 1 refresh failed
+ * @note   none
+ */
+uint8_t ssd1681_basic_refresh(void);
+
+/**
+ * @brief      basic example select the lut by the temperature
+ * @param[out] *temperature pointer to a temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 select failed
+ * @note       none
+ */
+uint8_t ssd1681_basic_select_lut(int16_t *temperature);
+
+/**
+ * @brief  basic example enter the deep sleep
+ * @return status code
+ *         - 0 success
+ *         - 1 sleep failed
+ * @note   call ssd1681_basic_resume before the next update
+ */
+uint8_t ssd1681_basic_sleep(void);
+
+/**
+ * @brief  basic example resume from the deep sleep
+ * @return status code
+ *         - 0 success
+ *         - 1 resume failed
+ * @note   none
+ */
+uint8_t ssd1681_basic_resume(void);
+
+/**
+ * @brief     basic example run the power manager
+ * @param[in] ms time passed since the last call in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 power process failed
+ * @note      call it periodically when the power manager is enabled
+ */
+uint8_t ssd1681_basic_power_process(uint32_t ms);
+
 /**
  * @brief     basic example clear
  * @param[in] color color type
@@ -88,6 +88,46 @@ uint8_t ssd1681_interface_spi_read_cmd(uint8_t *buf, uint16_t len)
     return 0;
 }
 
+/**
+ * @brief     interface spi bus set the frequency
+ * @param[in] freq spi clock frequency in hz
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the frequency is also used by the next spi init and the platform may round it down
+ */
+uint8_t ssd1681_interface_spi_set_frequency(uint32_t freq)
+{
+    return 0;
+}
+
+/**
+ * @brief      interface spi bus get the frequency
+ * @param[out] *freq pointer to a spi clock frequency buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+uint8_t ssd1681_interface_spi_get_frequency(uint32_t *freq)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface spi bus write command with the dma
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      it returns after the transfer is started and ssd1681_dma_irq_handler must be called when it is done
+ */
+uint8_t ssd1681_interface_spi_write_cmd_dma(uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -218,3 +258,16 @@ uint8_t ssd1681_interface_busy_gpio_read(uint8_t *value)
 {
     return 0;
 }
+
+/**
+ * @brief     interface busy gpio wait
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ * @note      it returns when the busy gpio is low or the timeout is reached
+ */
+uint8_t ssd1681_interface_busy_gpio_wait(uint32_t timeout_ms)
+{
+    return 0;
+}
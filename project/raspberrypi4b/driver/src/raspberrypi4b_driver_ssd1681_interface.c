@@ -37,6 +37,7 @@
 #include "driver_ssd1681_interface.h"
 #include "spi.h"
 #include "wire.h"
+#include "worker.h"
 #include <stdarg.h>
 
 /**
@@ -44,21 +45,399 @@
  */
 #define SPI_DEVICE_NAME "/dev/spidev0.0"    /**< spi device name */
 
+/**
+ * @brief spi default frequency definition
+ */
+#define SPI_DEFAULT_FREQUENCY 1000000       /**< 1MHz */
+
+/**
+ * @brief worker cpu definition
+ */
+#ifndef WORKER_CPU
+    #define WORKER_CPU -1                   /**< no pinning */
+#endif
+
+/**
+ * @brief worker priority definition
+ */
+#ifndef WORKER_PRIORITY
+    #define WORKER_PRIORITY 0               /**< default scheduler */
+#endif
+
+/**
+ * @brief interface job structure definition
+ */
+typedef struct interface_job_s
+{
+    uint8_t *buf;          /**< data buffer */
+    uint16_t len;          /**< data length */
+    uint32_t value;        /**< job value */
+    uint8_t res;           /**< job result */
+} interface_job_t;
+
 /**
  * @brief spi device handle definition
  */
-static int gs_fd;                           /**< spi handle */
+static int gs_fd;                                           /**< spi handle, only used on the worker thread */
+static uint8_t gs_spi_inited = 0;                           /**< spi inited flag */
+static uint32_t gs_spi_freq = SPI_DEFAULT_FREQUENCY;        /**< spi frequency */
+static uint8_t gs_open = 0;                                 /**< opened spi and gpio count */
+static interface_job_t gs_dma_job;                          /**< dma job */
+
+/**
+ * @brief     save the job result
+ * @param[in] res job result
+ * @param[in] *arg pointer to a job
+ * @note      it runs on the worker thread
+ */
+static void a_interface_job_done(uint8_t res, void *arg)
+{
+    ((interface_job_t *)arg)->res = res;
+}
+
+/**
+ * @brief     report the dma job result
+ * @param[in] res job result
+ * @param[in] *arg pointer to a job
+ * @note      it runs on the worker thread like an irq
+ */
+static void a_interface_dma_done(uint8_t res, void *arg)
+{
+    (void)arg;
+    
+    spi_dma_irq_handler(res);
+}
+
+/**
+ * @brief     run a job on the worker and wait for it
+ * @param[in] job pointer to a job function
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the worker is started by the first job
+ */
+static uint8_t a_interface_run(worker_job_t job, interface_job_t *arg)
+{
+    /* start the worker */
+    if (worker_init(WORKER_CPU, WORKER_PRIORITY) != 0)
+    {
+        return 1;
+    }
+    
+    /* run the job */
+    arg->res = 1;
+    if (worker_submit(job, a_interface_job_done, arg) != 0)
+    {
+        return 1;
+    }
+    if (worker_flush() != 0)
+    {
+        return 1;
+    }
+    
+    return arg->res;
+}
+
+/**
+ * @brief     open a spi or gpio resource
+ * @param[in] res open result
+ * @return    open result
+ * @note      the worker is stopped if nothing is opened
+ */
+static uint8_t a_interface_open(uint8_t res)
+{
+    if (res == 0)
+    {
+        gs_open++;
+    }
+    else if (gs_open == 0)
+    {
+        (void)worker_deinit();
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     close a spi or gpio resource
+ * @param[in] res close result
+ * @return    close result
+ * @note      the worker is stopped with the last resource
+ */
+static uint8_t a_interface_close(uint8_t res)
+{
+    if (gs_open != 0)
+    {
+        gs_open--;
+    }
+    if (gs_open == 0)
+    {
+        (void)worker_deinit();
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     spi init job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      none
+ */
+static uint8_t a_interface_spi_init_job(void *arg)
+{
+    return spi_init(SPI_DEVICE_NAME, &gs_fd, SPI_MODE_TYPE_3, ((interface_job_t *)arg)->value);
+}
+
+/**
+ * @brief     spi deinit job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      none
+ */
+static uint8_t a_interface_spi_deinit_job(void *arg)
+{
+    (void)arg;
+    
+    return spi_deinit(gs_fd);
+}
+
+/**
+ * @brief     spi write job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_interface_spi_write_job(void *arg)
+{
+    return spi_write_cmd(gs_fd, ((interface_job_t *)arg)->buf, ((interface_job_t *)arg)->len);
+}
+
+/**
+ * @brief     spi read job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      none
+ */
+static uint8_t a_interface_spi_read_job(void *arg)
+{
+    return spi_read_cmd(gs_fd, ((interface_job_t *)arg)->buf, ((interface_job_t *)arg)->len);
+}
+
+/**
+ * @brief     spi set frequency job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      none
+ */
+static uint8_t a_interface_spi_set_frequency_job(void *arg)
+{
+    return spi_set_frequency(gs_fd, ((interface_job_t *)arg)->value);
+}
+
+/**
+ * @brief     spi get frequency job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 get failed
+ * @note      none
+ */
+static uint8_t a_interface_spi_get_frequency_job(void *arg)
+{
+    return spi_get_frequency(gs_fd, &((interface_job_t *)arg)->value);
+}
+
+/**
+ * @brief     cs gpio init job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio init failed
+ * @note      none
+ */
+static uint8_t a_interface_cs_init_job(void *arg)
+{
+    (void)arg;
+    
+    return wire_cs_init();
+}
+
+/**
+ * @brief     cs gpio deinit job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio deinit failed
+ * @note      none
+ */
+static uint8_t a_interface_cs_deinit_job(void *arg)
+{
+    (void)arg;
+    
+    return wire_cs_deinit();
+}
+
+/**
+ * @brief     cs gpio write job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio write failed
+ * @note      none
+ */
+static uint8_t a_interface_cs_write_job(void *arg)
+{
+    return wire_cs_write((uint8_t)((interface_job_t *)arg)->value);
+}
+
+/**
+ * @brief     clock gpio init job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio init failed
+ * @note      none
+ */
+static uint8_t a_interface_clock_init_job(void *arg)
+{
+    (void)arg;
+    
+    return wire_clock_init();
+}
+
+/**
+ * @brief     clock gpio deinit job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio deinit failed
+ * @note      none
+ */
+static uint8_t a_interface_clock_deinit_job(void *arg)
+{
+    (void)arg;
+    
+    return wire_clock_deinit();
+}
+
+/**
+ * @brief     clock gpio write job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio write failed
+ * @note      none
+ */
+static uint8_t a_interface_clock_write_job(void *arg)
+{
+    return wire_clock_write((uint8_t)((interface_job_t *)arg)->value);
+}
+
+/**
+ * @brief     wire init job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio init failed
+ * @note      none
+ */
+static uint8_t a_interface_wire_init_job(void *arg)
+{
+    (void)arg;
+    
+    return wire_init();
+}
+
+/**
+ * @brief     wire deinit job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio deinit failed
+ * @note      none
+ */
+static uint8_t a_interface_wire_deinit_job(void *arg)
+{
+    (void)arg;
+    
+    return wire_deinit();
+}
+
+/**
+ * @brief     wire read job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio read failed
+ * @note      none
+ */
+static uint8_t a_interface_wire_read_job(void *arg)
+{
+    return wire_read(((interface_job_t *)arg)->buf);
+}
+
+/**
+ * @brief     wire wait low job
+ * @param[in] *arg pointer to a job
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ * @note      the gpio is polled every 1ms
+ */
+static uint8_t a_interface_wire_wait_job(void *arg)
+{
+    uint8_t value;
+    uint32_t i;
+    
+    /* poll the busy every 1ms */
+    for (i = 0; i <= ((interface_job_t *)arg)->value; i++)
+    {
+        if (wire_read(&value) != 0)
+        {
+            return 1;
+        }
+        if (value == 0)
+        {
+            return 0;
+        }
+        usleep(1000);
+    }
+    
+    return 1;
+}
 
 /**
  * @brief  interface spi bus init
  * @return status code
  *         - 0 success
  *         - 1 spi init failed
- * @note   none
+ * @note   the spi is opened and used on the worker thread
  */
 uint8_t ssd1681_interface_spi_init(void)
 {
-    return spi_init(SPI_DEVICE_NAME, &gs_fd, SPI_MODE_TYPE_3, 1000 * 1000);
+    interface_job_t job;
+    
+    /* open the spi */
+    job.value = gs_spi_freq;
+    if (a_interface_open(a_interface_run(a_interface_spi_init_job, &job)) != 0)
+    {
+        return 1;
+    }
+    gs_spi_inited = 1;
+    
+    return 0;
 }
 
 /**
@@ -70,7 +449,11 @@ uint8_t ssd1681_interface_spi_init(void)
  */
 uint8_t ssd1681_interface_spi_deinit(void)
 {
-    return spi_deinit(gs_fd);
+    interface_job_t job;
+    
+    gs_spi_inited = 0;
+    
+    return a_interface_close(a_interface_run(a_interface_spi_deinit_job, &job));
 }
 
 /**
@@ -84,7 +467,12 @@ uint8_t ssd1681_interface_spi_deinit(void)
  */
 uint8_t ssd1681_interface_spi_write_cmd(uint8_t *buf, uint16_t len)
 {
-    return spi_write_cmd(gs_fd, buf, len);
+    interface_job_t job;
+    
+    job.buf = buf;
+    job.len = len;
+    
+    return a_interface_run(a_interface_spi_write_job, &job);
 }
 
 /**
@@ -98,7 +486,90 @@ uint8_t ssd1681_interface_spi_write_cmd(uint8_t *buf, uint16_t len)
  */
 uint8_t ssd1681_interface_spi_read_cmd(uint8_t *buf, uint16_t len)
 {
-    return spi_read_cmd(gs_fd, buf, len);
+    interface_job_t job;
+    
+    job.buf = buf;
+    job.len = len;
+    
+    return a_interface_run(a_interface_spi_read_job, &job);
+}
+
+/**
+ * @brief     interface spi bus set the frequency
+ * @param[in] freq spi clock frequency in hz
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the frequency is also used by the next spi init and the platform may round it down
+ */
+uint8_t ssd1681_interface_spi_set_frequency(uint32_t freq)
+{
+    interface_job_t job;
+    
+    /* save the frequency */
+    gs_spi_freq = freq;
+    
+    /* apply it when the bus is opened */
+    if (gs_spi_inited != 0)
+    {
+        job.value = freq;
+        
+        return a_interface_run(a_interface_spi_set_frequency_job, &job);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      interface spi bus get the frequency
+ * @param[out] *freq pointer to a spi clock frequency buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+uint8_t ssd1681_interface_spi_get_frequency(uint32_t *freq)
+{
+    interface_job_t job;
+    
+    /* check the bus */
+    if (gs_spi_inited != 0)
+    {
+        if (a_interface_run(a_interface_spi_get_frequency_job, &job) != 0)
+        {
+            return 1;
+        }
+        *freq = job.value;
+        
+        return 0;
+    }
+    *freq = gs_spi_freq;
+    
+    return 0;
+}
+
+/**
+ * @brief     interface spi bus write command with the dma
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      it returns after the transfer is queued on the worker thread,
+ *            spi_dma_irq_handler is called on the worker thread when it is done,
+ *            so g_spi_dma_irq must not call the bus functions like a real irq
+ */
+uint8_t ssd1681_interface_spi_write_cmd_dma(uint8_t *buf, uint16_t len)
+{
+    /* queue the transfer */
+    gs_dma_job.buf = buf;
+    gs_dma_job.len = len;
+    if (worker_submit(a_interface_spi_write_job, a_interface_dma_done, &gs_dma_job) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
 }
 
 /**
@@ -138,7 +609,9 @@ void ssd1681_interface_debug_print(const char *const fmt, ...)
  */
 uint8_t ssd1681_interface_spi_cmd_data_gpio_init(void)
 {
-    return wire_cs_init();
+    interface_job_t job;
+    
+    return a_interface_open(a_interface_run(a_interface_cs_init_job, &job));
 }
 
 /**
@@ -150,7 +623,9 @@ uint8_t ssd1681_interface_spi_cmd_data_gpio_init(void)
  */
 uint8_t ssd1681_interface_spi_cmd_data_gpio_deinit(void)
 {
-    return wire_cs_deinit();
+    interface_job_t job;
+    
+    return a_interface_close(a_interface_run(a_interface_cs_deinit_job, &job));
 }
 
 /**
@@ -163,7 +638,11 @@ uint8_t ssd1681_interface_spi_cmd_data_gpio_deinit(void)
  */
 uint8_t ssd1681_interface_spi_cmd_data_gpio_write(uint8_t value)
 {
-    return wire_cs_write(value);
+    interface_job_t job;
+    
+    job.value = value;
+    
+    return a_interface_run(a_interface_cs_write_job, &job);
 }
 
 /**
@@ -175,7 +654,9 @@ uint8_t ssd1681_interface_spi_cmd_data_gpio_write(uint8_t value)
  */
 uint8_t ssd1681_interface_reset_gpio_init(void)
 {
-    return wire_clock_init();
+    interface_job_t job;
+    
+    return a_interface_open(a_interface_run(a_interface_clock_init_job, &job));
 }
 
 /**
@@ -187,7 +668,9 @@ uint8_t ssd1681_interface_reset_gpio_init(void)
  */
 uint8_t ssd1681_interface_reset_gpio_deinit(void)
 {
-    return wire_clock_deinit();
+    interface_job_t job;
+    
+    return a_interface_close(a_interface_run(a_interface_clock_deinit_job, &job));
 }
 
 /**
@@ -200,7 +683,11 @@ uint8_t ssd1681_interface_reset_gpio_deinit(void)
  */
 uint8_t ssd1681_interface_reset_gpio_write(uint8_t value)
 {
-    return wire_clock_write(value);
+    interface_job_t job;
+    
+    job.value = value;
+    
+    return a_interface_run(a_interface_clock_write_job, &job);
 }
 
 /**
@@ -212,7 +699,9 @@ uint8_t ssd1681_interface_reset_gpio_write(uint8_t value)
  */
 uint8_t ssd1681_interface_busy_gpio_init(void)
 {
-    return wire_init();
+    interface_job_t job;
+    
+    return a_interface_open(a_interface_run(a_interface_wire_init_job, &job));
 }
 
 /**
@@ -224,7 +713,9 @@ uint8_t ssd1681_interface_busy_gpio_init(void)
  */
 uint8_t ssd1681_interface_busy_gpio_deinit(void)
 {
-    return wire_deinit();
+    interface_job_t job;
+    
+    return a_interface_close(a_interface_run(a_interface_wire_deinit_job, &job));
 }
 
 /**
@@ -237,5 +728,28 @@ uint8_t ssd1681_interface_busy_gpio_deinit(void)
  */
 uint8_t ssd1681_interface_busy_gpio_read(uint8_t *value)
 {
-    return wire_read(value);
+    interface_job_t job;
+    
+    job.buf = value;
+    
+    return a_interface_run(a_interface_wire_read_job, &job);
+}
+
+/**
+ * @brief     interface busy gpio wait
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ * @note      it returns when the busy gpio is low or the timeout is reached,
+ *            the busy gpio is polled every 1ms
+ */
+uint8_t ssd1681_interface_busy_gpio_wait(uint32_t timeout_ms)
+{
+    interface_job_t job;
+    
+    /* poll on the worker thread */
+    job.value = timeout_ms;
+    
+    return a_interface_run(a_interface_wire_wait_job, &job);
 }
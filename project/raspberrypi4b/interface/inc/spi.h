@@ -65,6 +65,11 @@ typedef enum
     SPI_MODE_TYPE_3 = SPI_MODE_3,        /**< mode 3 */
 } spi_mode_type_t;
 
+/**
+ * @brief spi dma irq callback definition
+ */
+extern uint8_t (*g_spi_dma_irq)(uint8_t res);
+
 /**
  * @brief      spi bus init
  * @param[in]  *name pointer to a spi device name buffer
@@ -88,6 +93,28 @@ uint8_t spi_init(char *name, int *fd, spi_mode_type_t mode, uint32_t freq);
  */
 uint8_t spi_deinit(int fd);
 
+/**
+ * @brief     spi bus set the frequency
+ * @param[in] fd spi handle
+ * @param[in] freq spi running frequence
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      none
+ */
+uint8_t spi_set_frequency(int fd, uint32_t freq);
+
+/**
+ * @brief      spi bus get the frequency
+ * @param[in]  fd spi handle
+ * @param[out] *freq pointer to a spi running frequence buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+uint8_t spi_get_frequency(int fd, uint32_t *freq);
+
 /**
  * @brief      spi bus read command
  * @param[in]  fd spi handle
@@ -191,6 +218,13 @@ uint8_t spi_write_read(int fd, uint8_t *in_buf, uint32_t in_len, uint8_t *out_bu
  */
 uint8_t spi_transmit(int fd, uint8_t *tx, uint8_t *rx, uint16_t len);
 
+/**
+ * @brief     spi dma irq handler
+ * @param[in] res transfer result
+ * @note      it is called when a queued transfer is done and calls g_spi_dma_irq
+ */
+void spi_dma_irq_handler(uint8_t res);
+
 /**
  * @}
  */
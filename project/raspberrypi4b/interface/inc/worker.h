@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      worker.h
+ * @brief     worker header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef WORKER_H
+#define WORKER_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup worker worker function
+ * @brief    worker function modules
+ * @{
+ */
+
+/**
+ * @brief worker queue size definition
+ */
+#ifndef WORKER_QUEUE_SIZE
+    #define WORKER_QUEUE_SIZE 64        /**< must be a power of 2 */
+#endif
+
+/**
+ * @brief worker job function type definition
+ */
+typedef uint8_t (*worker_job_t)(void *arg);
+
+/**
+ * @brief worker completion callback type definition
+ */
+typedef void (*worker_callback_t)(uint8_t res, void *arg);
+
+/**
+ * @brief     worker init
+ * @param[in] cpu pinned cpu, -1 means no pinning
+ * @param[in] priority SCHED_FIFO priority, 0 means the default scheduler
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      all jobs run on the worker thread, so it is the only thread touching the spi and gpio
+ */
+uint8_t worker_init(int cpu, int priority);
+
+/**
+ * @brief  worker deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   the queued jobs are finished before the thread exits
+ */
+uint8_t worker_deinit(void);
+
+/**
+ * @brief     worker submit a job
+ * @param[in] job pointer to a job function
+ * @param[in] callback pointer to a completion callback, it can be NULL
+ * @param[in] *arg pointer to a job argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ *            - 2 queue is full
+ * @note      only one thread can submit, the callback runs on the worker thread
+ */
+uint8_t worker_submit(worker_job_t job, worker_callback_t callback, void *arg);
+
+/**
+ * @brief  worker wait until all submitted jobs are finished
+ * @return status code
+ *         - 0 success
+ *         - 1 flush failed
+ * @note   the caller sleeps on a condition signalled after each job
+ */
+uint8_t worker_flush(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
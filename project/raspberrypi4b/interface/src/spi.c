@@ -39,6 +39,11 @@
 #include <sys/ioctl.h>
 #include <fcntl.h>
 
+/**
+ * @brief global var definition
+ */
+uint8_t (*g_spi_dma_irq)(uint8_t res) = NULL;        /**< spi dma irq callback */
+
 /**
  * @brief      spi bus init
  * @param[in]  *name pointer to a spi device name buffer
@@ -159,6 +164,64 @@ uint8_t spi_deinit(int fd)
     }
 }
 
+/**
+ * @brief     spi bus set the frequency
+ * @param[in] fd spi handle
+ * @param[in] freq spi running frequence
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      none
+ */
+uint8_t spi_set_frequency(int fd, uint32_t freq)
+{
+    uint32_t i;
+    
+    /* set the spi write frequence */
+    i = freq;
+    if (ioctl(fd, SPI_IOC_WR_MAX_SPEED_HZ, &i) < 0)
+    {
+        perror("spi: set spi write speed failed.\n");
+        
+        return 1;
+    }
+    
+    /* set the spi read frequence */
+    if (ioctl(fd, SPI_IOC_RD_MAX_SPEED_HZ, &i) < 0)
+    {
+        perror("spi: set spi read speed failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      spi bus get the frequency
+ * @param[in]  fd spi handle
+ * @param[out] *freq pointer to a spi running frequence buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+uint8_t spi_get_frequency(int fd, uint32_t *freq)
+{
+    uint32_t i;
+    
+    /* get the spi frequence */
+    if (ioctl(fd, SPI_IOC_RD_MAX_SPEED_HZ, &i) < 0)
+    {
+        perror("spi: get spi speed failed.\n");
+        
+        return 1;
+    }
+    *freq = i;
+    
+    return 0;
+}
+
 /**
  * @brief      spi bus read command
  * @param[in]  fd spi handle
@@ -512,3 +575,17 @@ uint8_t spi_transmit(int fd, uint8_t *tx, uint8_t *rx, uint16_t len)
     
     return 0;
 }
+
+/**
+ * @brief     spi dma irq handler
+ * @param[in] res transfer result
+ * @note      it is called when a queued transfer is done and calls g_spi_dma_irq
+ */
+void spi_dma_irq_handler(uint8_t res)
+{
+    /* run the callback */
+    if (g_spi_dma_irq != NULL)
+    {
+        (void)g_spi_dma_irq(res);
+    }
+}
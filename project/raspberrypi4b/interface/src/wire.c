@@ -35,6 +35,9 @@
  */
 
 #include "wire.h"
+
+#ifndef WIRE_USE_GPIOMEM
+
 #include <gpiod.h>
 
 /**
@@ -334,3 +337,5 @@ uint8_t wire_cs_write(uint8_t value)
 
     return 0;
 }
+
+#endif
@@ -0,0 +1,383 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      wire_gpiomem.c
+ * @brief     wire gpiomem source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "wire.h"
+
+#ifdef WIRE_USE_GPIOMEM
+
+#include <fcntl.h>
+#include <sys/mman.h>
+
+/**
+ * @brief gpio device name definition
+ */
+#define GPIO_DEVICE_NAME "/dev/gpiomem"          /**< gpio device name */
+
+/**
+ * @brief gpio device line definition
+ */
+#define GPIO_DEVICE_LINE 17                      /**< gpio device line */
+#define GPIO_DEVICE_CLOCK_LINE 27                /**< gpio device clock line */
+#define GPIO_DEVICE_CS_LINE 22                   /**< gpio device cs line */
+
+/**
+ * @brief gpio register definition
+ */
+#define GPIO_MAP_SIZE 4096                       /**< gpio map size */
+#define GPIO_REG_GPFSEL0 (0x00 / 4)              /**< function select 0 register */
+#define GPIO_REG_GPSET0 (0x1C / 4)               /**< pin output set 0 register */
+#define GPIO_REG_GPCLR0 (0x28 / 4)               /**< pin output clear 0 register */
+#define GPIO_REG_GPLEV0 (0x34 / 4)               /**< pin level 0 register */
+
+/**
+ * @brief global var definition
+ */
+static volatile uint32_t *gs_gpio = NULL;        /**< gpio register base */
+static uint8_t gs_gpio_ref = 0;                  /**< gpio map reference count */
+static volatile uint8_t gs_read_write_flag;      /**< read write flag */
+
+/**
+ * @brief  map the gpio registers
+ * @return status code
+ *         - 0 success
+ *         - 1 map failed
+ * @note   the map is shared by all lines
+ */
+static uint8_t a_wire_gpiomem_map(void)
+{
+    int fd;
+    void *map;
+    
+    /* check the reference */
+    if (gs_gpio_ref != 0)
+    {
+        gs_gpio_ref++;
+        
+        return 0;
+    }
+    
+    /* open the device */
+    fd = open(GPIO_DEVICE_NAME, O_RDWR | O_SYNC);
+    if (fd < 0)
+    {
+        perror("gpio: open failed.\n");
+        
+        return 1;
+    }
+    
+    /* map the registers */
+    map = mmap(NULL, GPIO_MAP_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (map == MAP_FAILED)
+    {
+        perror("gpio: mmap failed.\n");
+        
+        return 1;
+    }
+    
+    /* save the base */
+    gs_gpio = (volatile uint32_t *)map;
+    gs_gpio_ref = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  unmap the gpio registers
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_wire_gpiomem_unmap(void)
+{
+    /* check the reference */
+    if (gs_gpio_ref == 0)
+    {
+        return 0;
+    }
+    
+    /* unmap when the last line is closed */
+    gs_gpio_ref--;
+    if (gs_gpio_ref == 0)
+    {
+        (void)munmap((void *)gs_gpio, GPIO_MAP_SIZE);
+        gs_gpio = NULL;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     set the gpio function
+ * @param[in] pin gpio pin
+ * @param[in] output 1 is output and 0 is input
+ * @note      none
+ */
+static void a_wire_gpiomem_set_function(uint32_t pin, uint8_t output)
+{
+    uint32_t reg;
+    uint32_t shift;
+    uint32_t prev;
+    
+    reg = GPIO_REG_GPFSEL0 + pin / 10;                       /* get the register */
+    shift = (pin % 10) * 3;                                  /* get the shift */
+    prev = gs_gpio[reg];                                     /* read the register */
+    prev &= ~(7U << shift);                                  /* clear the settings */
+    if (output != 0)                                         /* if output */
+    {
+        prev |= 1U << shift;                                 /* set output */
+    }
+    gs_gpio[reg] = prev;                                     /* write the register */
+}
+
+/**
+ * @brief     write the gpio level
+ * @param[in] pin gpio pin
+ * @param[in] value written value
+ * @note      none
+ */
+static inline void a_wire_gpiomem_write(uint32_t pin, uint8_t value)
+{
+    if (value != 0)
+    {
+        gs_gpio[GPIO_REG_GPSET0] = 1U << pin;                /* set high */
+    }
+    else
+    {
+        gs_gpio[GPIO_REG_GPCLR0] = 1U << pin;                /* set low */
+    }
+}
+
+/**
+ * @brief  wire bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+uint8_t wire_init(void)
+{
+    /* map the gpio */
+    if (a_wire_gpiomem_map() != 0)
+    {
+        return 1;
+    }
+    
+    /* set the flag */
+    gs_read_write_flag = 2;
+    
+    /* set high */
+    return wire_write(1);
+}
+
+/**
+ * @brief  wire bus deint
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wire_deinit(void)
+{
+    /* set input */
+    a_wire_gpiomem_set_function(GPIO_DEVICE_LINE, 0);
+    
+    return a_wire_gpiomem_unmap();
+}
+
+/**
+ * @brief      wire bus read data
+ * @param[out] *value pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t wire_read(uint8_t *value)
+{
+    /* check the flag */
+    if (gs_read_write_flag != 0)
+    {
+        /* set input */
+        a_wire_gpiomem_set_function(GPIO_DEVICE_LINE, 0);
+        
+        /* flag read */
+        gs_read_write_flag = 0;
+    }
+    
+    /* read the value */
+    *value = (uint8_t)((gs_gpio[GPIO_REG_GPLEV0] >> GPIO_DEVICE_LINE) & 0x01);
+    
+    return 0;
+}
+
+/**
+ * @brief     wire bus write data
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t wire_write(uint8_t value)
+{
+    /* check the flag */
+    if (gs_read_write_flag != 1)
+    {
+        /* set the level before enabling the output */
+        a_wire_gpiomem_write(GPIO_DEVICE_LINE, value);
+        
+        /* set output */
+        a_wire_gpiomem_set_function(GPIO_DEVICE_LINE, 1);
+        
+        /* flag write */
+        gs_read_write_flag = 1;
+    }
+    
+    /* set the value */
+    a_wire_gpiomem_write(GPIO_DEVICE_LINE, value);
+    
+    return 0;
+}
+
+/**
+ * @brief  wire bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+uint8_t wire_clock_init(void)
+{
+    /* map the gpio */
+    if (a_wire_gpiomem_map() != 0)
+    {
+        return 1;
+    }
+    
+    /* set high */
+    a_wire_gpiomem_write(GPIO_DEVICE_CLOCK_LINE, 1);
+    
+    /* set output */
+    a_wire_gpiomem_set_function(GPIO_DEVICE_CLOCK_LINE, 1);
+    
+    return 0;
+}
+
+/**
+ * @brief  wire bus deint
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wire_clock_deinit(void)
+{
+    /* set input */
+    a_wire_gpiomem_set_function(GPIO_DEVICE_CLOCK_LINE, 0);
+    
+    return a_wire_gpiomem_unmap();
+}
+
+/**
+ * @brief     wire bus write data
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t wire_clock_write(uint8_t value)
+{
+    /* write the value */
+    a_wire_gpiomem_write(GPIO_DEVICE_CLOCK_LINE, value);
+    
+    return 0;
+}
+
+/**
+ * @brief  wire bus cs init
+ * @return status code
+ *         - 0 success
+ *         - 1 failed 
+ * @note   none
+ */
+uint8_t wire_cs_init(void)
+{
+    /* map the gpio */
+    if (a_wire_gpiomem_map() != 0)
+    {
+        return 1;
+    }
+    
+    /* set cs high */
+    a_wire_gpiomem_write(GPIO_DEVICE_CS_LINE, 1);
+    
+    /* set output */
+    a_wire_gpiomem_set_function(GPIO_DEVICE_CS_LINE, 1);
+    
+    return 0;
+}
+
+/**
+ * @brief  wire bus cs deint
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wire_cs_deinit(void)
+{
+    /* set input */
+    a_wire_gpiomem_set_function(GPIO_DEVICE_CS_LINE, 0);
+    
+    return a_wire_gpiomem_unmap();
+}
+
+/**
+ * @brief     wire bus write data
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+uint8_t wire_cs_write(uint8_t value)
+{
+    /* set the value */
+    a_wire_gpiomem_write(GPIO_DEVICE_CS_LINE, value);
+    
+    return 0;
+}
+
+#endif
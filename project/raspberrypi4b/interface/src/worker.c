@@ -0,0 +1,327 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      worker.c
+ * @brief     worker source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _GNU_SOURCE
+
+#include "worker.h"
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+
+/**
+ * @brief worker item structure definition
+ */
+typedef struct worker_item_s
+{
+    worker_job_t job;                 /**< job function */
+    worker_callback_t callback;       /**< completion callback */
+    void *arg;                        /**< job argument */
+} worker_item_t;
+
+/**
+ * @brief global var definition
+ */
+static pthread_t gs_thread;                                    /**< worker thread */
+static sem_t gs_sem;                                           /**< job semaphore */
+static pthread_mutex_t gs_mutex;                               /**< completion mutex */
+static pthread_cond_t gs_cond;                                 /**< completion condition */
+static worker_item_t gs_queue[WORKER_QUEUE_SIZE];              /**< job queue */
+static volatile uint32_t gs_head;                              /**< producer index */
+static volatile uint32_t gs_tail;                              /**< consumer index */
+static volatile uint8_t gs_stop;                               /**< stop flag */
+static uint8_t gs_inited = 0;                                  /**< inited flag */
+
+/**
+ * @brief     worker thread
+ * @param[in] *p pointer to the thread argument
+ * @return    thread result
+ * @note      none
+ */
+static void *a_worker_thread(void *p)
+{
+    worker_item_t item;
+    uint32_t tail;
+    uint8_t res;
+    
+    (void)p;
+    
+    while (1)
+    {
+        /* wait for a job */
+        if (sem_wait(&gs_sem) != 0)
+        {
+            continue;
+        }
+        
+        /* check the queue */
+        tail = __atomic_load_n(&gs_tail, __ATOMIC_RELAXED);
+        if (tail == __atomic_load_n(&gs_head, __ATOMIC_ACQUIRE))
+        {
+            if (__atomic_load_n(&gs_stop, __ATOMIC_ACQUIRE) != 0)
+            {
+                break;
+            }
+            
+            continue;
+        }
+        
+        /* pop the job */
+        item = gs_queue[tail & (WORKER_QUEUE_SIZE - 1)];
+        
+        /* run the job */
+        res = item.job(item.arg);
+        
+        /* complete */
+        if (item.callback != NULL)
+        {
+            item.callback(res, item.arg);
+        }
+        
+        /* release the slot after the job is completed */
+        __atomic_store_n(&gs_tail, tail + 1, __ATOMIC_RELEASE);
+        
+        /* wake up the flush */
+        (void)pthread_mutex_lock(&gs_mutex);
+        (void)pthread_cond_broadcast(&gs_cond);
+        (void)pthread_mutex_unlock(&gs_mutex);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     worker init
+ * @param[in] cpu pinned cpu, -1 means no pinning
+ * @param[in] priority SCHED_FIFO priority, 0 means the default scheduler
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      all jobs run on the worker thread, so it is the only thread touching the spi and gpio
+ */
+uint8_t worker_init(int cpu, int priority)
+{
+    pthread_attr_t attr;
+    struct sched_param param;
+    cpu_set_t set;
+    
+    /* check the size */
+    if ((WORKER_QUEUE_SIZE & (WORKER_QUEUE_SIZE - 1)) != 0)
+    {
+        perror("worker: queue size is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* check the inited */
+    if (gs_inited != 0)
+    {
+        return 0;
+    }
+    
+    /* init the queue */
+    gs_head = 0;
+    gs_tail = 0;
+    gs_stop = 0;
+    if (sem_init(&gs_sem, 0, 0) != 0)
+    {
+        perror("worker: sem init failed.\n");
+        
+        return 1;
+    }
+    if (pthread_mutex_init(&gs_mutex, NULL) != 0)
+    {
+        perror("worker: mutex init failed.\n");
+        (void)sem_destroy(&gs_sem);
+        
+        return 1;
+    }
+    if (pthread_cond_init(&gs_cond, NULL) != 0)
+    {
+        perror("worker: cond init failed.\n");
+        (void)pthread_mutex_destroy(&gs_mutex);
+        (void)sem_destroy(&gs_sem);
+        
+        return 1;
+    }
+    
+    /* set the scheduler */
+    (void)pthread_attr_init(&attr);
+    if (priority > 0)
+    {
+        param.sched_priority = priority;
+        (void)pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        (void)pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        (void)pthread_attr_setschedparam(&attr, &param);
+    }
+    
+    /* set the cpu */
+    if (cpu >= 0)
+    {
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        (void)pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &set);
+    }
+    
+    /* create the thread */
+    if (pthread_create(&gs_thread, &attr, a_worker_thread, NULL) != 0)
+    {
+        perror("worker: create thread failed.\n");
+        (void)pthread_attr_destroy(&attr);
+        (void)pthread_cond_destroy(&gs_cond);
+        (void)pthread_mutex_destroy(&gs_mutex);
+        (void)sem_destroy(&gs_sem);
+        
+        return 1;
+    }
+    (void)pthread_attr_destroy(&attr);
+    gs_inited = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  worker deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   the queued jobs are finished before the thread exits
+ */
+uint8_t worker_deinit(void)
+{
+    /* check the inited */
+    if (gs_inited == 0)
+    {
+        return 0;
+    }
+    
+    /* stop the thread */
+    __atomic_store_n(&gs_stop, 1, __ATOMIC_RELEASE);
+    if (sem_post(&gs_sem) != 0)
+    {
+        perror("worker: sem post failed.\n");
+        
+        return 1;
+    }
+    if (pthread_join(gs_thread, NULL) != 0)
+    {
+        perror("worker: join thread failed.\n");
+        
+        return 1;
+    }
+    (void)pthread_cond_destroy(&gs_cond);
+    (void)pthread_mutex_destroy(&gs_mutex);
+    (void)sem_destroy(&gs_sem);
+    gs_inited = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     worker submit a job
+ * @param[in] job pointer to a job function
+ * @param[in] callback pointer to a completion callback, it can be NULL
+ * @param[in] *arg pointer to a job argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ *            - 2 queue is full
+ * @note      only one thread can submit, the callback runs on the worker thread
+ */
+uint8_t worker_submit(worker_job_t job, worker_callback_t callback, void *arg)
+{
+    uint32_t head;
+    
+    /* check the job */
+    if ((gs_inited == 0) || (job == NULL))
+    {
+        return 1;
+    }
+    
+    /* check the space */
+    head = __atomic_load_n(&gs_head, __ATOMIC_RELAXED);
+    if ((head - __atomic_load_n(&gs_tail, __ATOMIC_ACQUIRE)) >= WORKER_QUEUE_SIZE)
+    {
+        return 2;
+    }
+    
+    /* push the job */
+    gs_queue[head & (WORKER_QUEUE_SIZE - 1)].job = job;
+    gs_queue[head & (WORKER_QUEUE_SIZE - 1)].callback = callback;
+    gs_queue[head & (WORKER_QUEUE_SIZE - 1)].arg = arg;
+    __atomic_store_n(&gs_head, head + 1, __ATOMIC_RELEASE);
+    
+    /* wake up the worker */
+    if (sem_post(&gs_sem) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  worker wait until all submitted jobs are finished
+ * @return status code
+ *         - 0 success
+ *         - 1 flush failed
+ * @note   the caller sleeps on a condition signalled after each job
+ */
+uint8_t worker_flush(void)
+{
+    /* check the inited */
+    if (gs_inited == 0)
+    {
+        return 1;
+    }
+    
+    /* wait for the consumer */
+    if (pthread_mutex_lock(&gs_mutex) != 0)
+    {
+        return 1;
+    }
+    while (__atomic_load_n(&gs_tail, __ATOMIC_ACQUIRE) != __atomic_load_n(&gs_head, __ATOMIC_RELAXED))
+    {
+        if (pthread_cond_wait(&gs_cond, &gs_mutex) != 0)
+        {
+            (void)pthread_mutex_unlock(&gs_mutex);
+            
+            return 1;
+        }
+    }
+    (void)pthread_mutex_unlock(&gs_mutex);
+    
+    return 0;
+}
@@ -36,7 +36,10 @@
 
 #include "driver_ssd1681_basic.h"
 #include "driver_ssd1681_display_test.h"
+#include "driver_ssd1681_lut_test.h"
+#include "driver_ssd1681_spi_test.h"
 #include "shell.h"
+#include "spi.h"
 #include <getopt.h>
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -300,6 +303,30 @@ uint8_t ssd1681(uint8_t argc, char** argv)
             return 0;
         }
     }
+    else if (strcmp("t_lut", type) == 0)
+    {
+        /* run lut test */
+        if (ssd1681_lut_test() != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_spi", type) == 0)
+    {
+        /* run spi test */
+        if (ssd1681_spi_test() != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
     else if (strcmp("e_basic-str", type) == 0)
     {
         /* basic string */
@@ -328,6 +355,9 @@ uint8_t ssd1681(uint8_t argc, char** argv)
         }
         else
         {
+            /* link the dma irq */
+            g_spi_dma_irq = ssd1681_basic_dma_irq_handler;
+            
             ssd1681_interface_debug_print("ssd1681: init success.\n");
             
             return 0;
@@ -437,6 +467,8 @@ uint8_t ssd1681(uint8_t argc, char** argv)
         ssd1681_interface_debug_print("  ssd1681 (-h | --help)\n");
         ssd1681_interface_debug_print("  ssd1681 (-p | --port)\n");
         ssd1681_interface_debug_print("  ssd1681 (-t display | --test=display)\n");
+        ssd1681_interface_debug_print("  ssd1681 (-t lut | --test=lut)\n");
+        ssd1681_interface_debug_print("  ssd1681 (-t spi | --test=spi)\n");
         ssd1681_interface_debug_print("  ssd1681 (-e basic-init | --example=basic-init)\n");
         ssd1681_interface_debug_print("  ssd1681 (-e basic-deinit | --example=basic-deinit)\n");
         ssd1681_interface_debug_print("  ssd1681 (-e basic-str | --example=basic-str) [--str=<string>] [--mode=<RED | BLACK>] [--color=<0 | 1>]\n");
@@ -455,7 +487,7 @@ uint8_t ssd1681(uint8_t argc, char** argv)
         ssd1681_interface_debug_print("                          Set the chip display mode.([default: BLACK])\n");
         ssd1681_interface_debug_print("  -p, --port              Display the pin connections of the current board.\n");
         ssd1681_interface_debug_print("      --str=<string>      Set the display string.([default: libdriver])\n");
-        ssd1681_interface_debug_print("  -t <display>, --test=<display>\n");
+        ssd1681_interface_debug_print("  -t <display | lut | spi>, --test=<display | lut | spi>\n");
         ssd1681_interface_debug_print("                          Run the driver test.\n");
         ssd1681_interface_debug_print("      --x0=<x0>           Set the x0 and it is the x of the point.\n");
         ssd1681_interface_debug_print("      --x1=<x1>           Set the x1 and it is the top left x of the rect.\n");
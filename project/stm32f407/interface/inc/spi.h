@@ -60,6 +60,11 @@ typedef enum
     SPI_MODE_3 = 0x03,        /**< mode 3 */
 } spi_mode_t;
 
+/**
+ * @brief spi dma irq callback definition
+ */
+extern uint8_t (*g_spi_dma_irq)(uint8_t res);
+
 /**
  * @brief     spi bus init
  * @param[in] mode spi mode
@@ -79,6 +84,25 @@ uint8_t spi_init(spi_mode_t mode);
  */
 uint8_t spi_deinit(void);
 
+/**
+ * @brief     spi bus set the frequency
+ * @param[in] freq spi clock frequency
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the nearest prescaler not above freq is used
+ */
+uint8_t spi_set_frequency(uint32_t freq);
+
+/**
+ * @brief      spi bus get the frequency
+ * @param[out] *freq pointer to a spi clock frequency buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t spi_get_frequency(uint32_t *freq);
+
 /**
  * @brief     spi bus write command
  * @param[in] *buf pointer to a data buffer
@@ -90,6 +114,38 @@ uint8_t spi_deinit(void);
  */
 uint8_t spi_write_cmd(uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     spi bus write command with the dma
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      it returns after the transfer is started, cs is kept low until spi_dma_irq_handler
+ */
+uint8_t spi_write_cmd_dma(uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     spi dma irq handler
+ * @param[in] res transfer result
+ * @note      it releases the cs and calls g_spi_dma_irq
+ */
+void spi_dma_irq_handler(uint8_t res);
+
+/**
+ * @brief  spi get the handle
+ * @return pointer to a spi handle
+ * @note   none
+ */
+SPI_HandleTypeDef* spi_get_handle(void);
+
+/**
+ * @brief  spi get the dma tx handle
+ * @return pointer to a dma handle
+ * @note   none
+ */
+DMA_HandleTypeDef* spi_get_dma_tx_handle(void);
+
 /**
  * @brief     spi bus write
  * @param[in] addr spi register address
@@ -83,6 +83,38 @@ uint8_t wire_read(uint8_t *value);
  */
 uint8_t wire_write(uint8_t value);
 
+/**
+ * @brief  wire bus falling edge irq init
+ * @return status code
+ *         - 0 success
+ * @note   IO is PA8 and it must be called after wire_init
+ */
+uint8_t wire_irq_init(void);
+
+/**
+ * @brief  wire bus falling edge irq deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wire_irq_deinit(void);
+
+/**
+ * @brief     wire bus wait until the data is low
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      the core sleeps with wfi and wakes up on the falling edge irq or the systick
+ */
+uint8_t wire_wait_low(uint32_t timeout_ms);
+
+/**
+ * @brief wire bus falling edge irq handler
+ * @note  none
+ */
+void wire_irq_handler(void);
+
 /**
  * @brief  wire bus init
  * @return status code
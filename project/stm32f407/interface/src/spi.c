@@ -39,7 +39,10 @@
 /**
  * @brief spi var definition
  */
-SPI_HandleTypeDef g_spi_handle;        /**< spi handle */
+SPI_HandleTypeDef g_spi_handle;                                  /**< spi handle */
+DMA_HandleTypeDef g_spi_dma_tx_handle;                           /**< spi dma tx handle */
+uint8_t (*g_spi_dma_irq)(uint8_t res) = NULL;                    /**< spi dma irq callback */
+static uint32_t gs_prescaler = SPI_BAUDRATEPRESCALER_32;         /**< spi baud rate prescaler */
 
 /**
  * @brief  spi cs init
@@ -101,7 +104,7 @@ uint8_t spi_init(spi_mode_t mode)
         g_spi_handle.Init.CLKPhase = SPI_PHASE_2EDGE;
     }
     g_spi_handle.Init.NSS = SPI_NSS_SOFT;
-    g_spi_handle.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_32;
+    g_spi_handle.Init.BaudRatePrescaler = gs_prescaler;
     g_spi_handle.Init.FirstBit = SPI_FIRSTBIT_MSB;
     g_spi_handle.Init.TIMode = SPI_TIMODE_DISABLE;
     g_spi_handle.Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
@@ -137,6 +140,69 @@ uint8_t spi_deinit(void)
     return 0;
 }
 
+/**
+ * @brief     spi bus set the frequency
+ * @param[in] freq spi clock frequency
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the nearest prescaler not above freq is used
+ */
+uint8_t spi_set_frequency(uint32_t freq)
+{
+    const uint32_t prescaler[8] = {SPI_BAUDRATEPRESCALER_2, SPI_BAUDRATEPRESCALER_4, SPI_BAUDRATEPRESCALER_8,
+                                   SPI_BAUDRATEPRESCALER_16, SPI_BAUDRATEPRESCALER_32, SPI_BAUDRATEPRESCALER_64,
+                                   SPI_BAUDRATEPRESCALER_128, SPI_BAUDRATEPRESCALER_256};
+    uint32_t pclk;
+    uint8_t i;
+    
+    /* spi1 is on the apb2 */
+    pclk = HAL_RCC_GetPCLK2Freq();
+    
+    /* find the fastest clock not above freq */
+    for (i = 0; i < 7; i++)
+    {
+        if ((pclk >> (i + 1)) <= freq)
+        {
+            break;
+        }
+    }
+    gs_prescaler = prescaler[i];
+    
+    /* apply it at the next init if the spi is closed */
+    if (g_spi_handle.State == HAL_SPI_STATE_RESET)
+    {
+        return 0;
+    }
+    
+    /* reinit the spi */
+    g_spi_handle.Init.BaudRatePrescaler = gs_prescaler;
+    if (HAL_SPI_Init(&g_spi_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      spi bus get the frequency
+ * @param[out] *freq pointer to a spi clock frequency buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t spi_get_frequency(uint32_t *freq)
+{
+    uint32_t shift;
+    
+    /* prescaler is 2 << (BR[2:0]) */
+    shift = (gs_prescaler >> 3) + 1;
+    *freq = HAL_RCC_GetPCLK2Freq() >> shift;
+    
+    return 0;
+}
+
 /**
  * @brief     spi bus write command
  * @param[in] *buf pointer to a data buffer
@@ -173,6 +239,75 @@ uint8_t spi_write_cmd(uint8_t *buf, uint16_t len)
     return 0;
 }
 
+/**
+ * @brief     spi bus write command with the dma
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      it returns after the transfer is started, cs is kept low until spi_dma_irq_handler
+ */
+uint8_t spi_write_cmd_dma(uint8_t *buf, uint16_t len)
+{
+    /* check the length */
+    if (len == 0)
+    {
+        return 1;
+    }
+    
+    /* set cs low */
+    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_4, GPIO_PIN_RESET);
+    
+    /* start the dma */
+    if (HAL_SPI_Transmit_DMA(&g_spi_handle, buf, len) != HAL_OK)
+    {
+        /* set cs high */
+        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_4, GPIO_PIN_SET);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     spi dma irq handler
+ * @param[in] res transfer result
+ * @note      it releases the cs and calls g_spi_dma_irq
+ */
+void spi_dma_irq_handler(uint8_t res)
+{
+    /* set cs high */
+    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_4, GPIO_PIN_SET);
+    
+    /* run the callback */
+    if (g_spi_dma_irq != NULL)
+    {
+        (void)g_spi_dma_irq(res);
+    }
+}
+
+/**
+ * @brief  spi get the handle
+ * @return pointer to a spi handle
+ * @note   none
+ */
+SPI_HandleTypeDef* spi_get_handle(void)
+{
+    return &g_spi_handle;
+}
+
+/**
+ * @brief  spi get the dma tx handle
+ * @return pointer to a dma handle
+ * @note   none
+ */
+DMA_HandleTypeDef* spi_get_dma_tx_handle(void)
+{
+    return &g_spi_dma_tx_handle;
+}
+
 /**
  * @brief     spi bus write
  * @param[in] addr spi register address
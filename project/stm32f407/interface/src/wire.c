@@ -55,6 +55,8 @@
 #define DQ_OUT                 PAout(8)
 #define DQ_IN                  PAin(8)
 
+static volatile uint8_t gs_falling = 0;        /**< falling edge flag */
+
 /**
  * @brief  wire bus init
  * @return status code
@@ -137,6 +139,103 @@ uint8_t wire_write(uint8_t value)
     return 0;
 }
 
+/**
+ * @brief  wire bus falling edge irq init
+ * @return status code
+ *         - 0 success
+ * @note   IO is PA8 and it must be called after wire_init
+ */
+uint8_t wire_irq_init(void)
+{
+    /* enable syscfg clock */
+    __HAL_RCC_SYSCFG_CLK_ENABLE();
+    
+    /* connect PA8 to the exti line 8 */
+    SYSCFG->EXTICR[2] = (SYSCFG->EXTICR[2] & ~SYSCFG_EXTICR3_EXTI8) | SYSCFG_EXTICR3_EXTI8_PA;
+    
+    /* falling edge only */
+    EXTI->RTSR &= ~GPIO_PIN_8;
+    EXTI->FTSR |= GPIO_PIN_8;
+    
+    /* clear the pending flag */
+    __HAL_GPIO_EXTI_CLEAR_IT(GPIO_PIN_8);
+    gs_falling = 0;
+    
+    /* enable the interrupt */
+    EXTI->IMR |= GPIO_PIN_8;
+    HAL_NVIC_SetPriority(EXTI9_5_IRQn, 2, 0);
+    HAL_NVIC_EnableIRQ(EXTI9_5_IRQn);
+    
+    return 0;
+}
+
+/**
+ * @brief  wire bus falling edge irq deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wire_irq_deinit(void)
+{
+    /* disable the interrupt */
+    EXTI->IMR &= ~GPIO_PIN_8;
+    EXTI->FTSR &= ~GPIO_PIN_8;
+    HAL_NVIC_DisableIRQ(EXTI9_5_IRQn);
+    
+    return 0;
+}
+
+/**
+ * @brief     wire bus wait until the data is low
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      the core sleeps with wfi and wakes up on the falling edge irq or the systick
+ */
+uint8_t wire_wait_low(uint32_t timeout_ms)
+{
+    uint32_t start;
+    
+    /* input mode */
+    IO_IN();
+    
+    /* save the start tick */
+    start = HAL_GetTick();
+    gs_falling = 0;
+    while (1)
+    {
+        /* mask the irq so that the edge can't be lost between the check and the wfi */
+        __disable_irq();
+        if ((gs_falling != 0) || (DQ_IN == 0))
+        {
+            __enable_irq();
+            
+            return 0;
+        }
+        if ((HAL_GetTick() - start) >= timeout_ms)
+        {
+            __enable_irq();
+            
+            return 1;
+        }
+        
+        /* a pending irq still wakes up the core */
+        __WFI();
+        __enable_irq();
+    }
+}
+
+/**
+ * @brief wire bus falling edge irq handler
+ * @note  none
+ */
+void wire_irq_handler(void)
+{
+    /* set the flag */
+    gs_falling = 1;
+}
+
 /**
  * @brief  wire bus init
  * @return status code
@@ -35,6 +35,7 @@
  */
 
 #include "stm32f4xx_hal.h"
+#include "spi.h"
 
 /** 
  * @defgroup msp HAL_MSP_Private_Functions
@@ -175,6 +176,27 @@ void HAL_SPI_MspInit(SPI_HandleTypeDef* hspi)
         GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
         GPIO_InitStruct.Alternate = GPIO_AF5_SPI1;
         HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+        
+        /* enable dma2 clock */
+        __HAL_RCC_DMA2_CLK_ENABLE();
+        
+        /* spi1 tx is dma2 stream3 channel3 */
+        spi_get_dma_tx_handle()->Instance = DMA2_Stream3;
+        spi_get_dma_tx_handle()->Init.Channel = DMA_CHANNEL_3;
+        spi_get_dma_tx_handle()->Init.Direction = DMA_MEMORY_TO_PERIPH;
+        spi_get_dma_tx_handle()->Init.PeriphInc = DMA_PINC_DISABLE;
+        spi_get_dma_tx_handle()->Init.MemInc = DMA_MINC_ENABLE;
+        spi_get_dma_tx_handle()->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        spi_get_dma_tx_handle()->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+        spi_get_dma_tx_handle()->Init.Mode = DMA_NORMAL;
+        spi_get_dma_tx_handle()->Init.Priority = DMA_PRIORITY_HIGH;
+        spi_get_dma_tx_handle()->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+        (void)HAL_DMA_Init(spi_get_dma_tx_handle());
+        __HAL_LINKDMA(hspi, hdmatx, *spi_get_dma_tx_handle());
+        
+        /* enable the dma irq */
+        HAL_NVIC_SetPriority(DMA2_Stream3_IRQn, 3, 0);
+        HAL_NVIC_EnableIRQ(DMA2_Stream3_IRQn);
     }
 }
 
@@ -192,6 +214,10 @@ void HAL_SPI_MspDeInit(SPI_HandleTypeDef* hspi)
         
         /* spi gpio deinit */
         HAL_GPIO_DeInit(GPIOA, GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_7);
+        
+        /* dma deinit */
+        (void)HAL_DMA_DeInit(hspi->hdmatx);
+        HAL_NVIC_DisableIRQ(DMA2_Stream3_IRQn);
     }
 }
 
@@ -36,6 +36,8 @@
 
 #include "stm32f4xx_it.h"
 #include "uart.h"
+#include "spi.h"
+#include "wire.h"
 
 /**
  * @brief nmi handler
@@ -164,6 +166,24 @@ void USART2_IRQHandler(void)
     HAL_UART_IRQHandler(uart2_get_handle());
 }
 
+/**
+ * @brief dma2 stream3 irq handler
+ * @note  none
+ */
+void DMA2_Stream3_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(spi_get_dma_tx_handle());
+}
+
+/**
+ * @brief exti9_5 irq handler
+ * @note  none
+ */
+void EXTI9_5_IRQHandler(void)
+{
+    HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_8);
+}
+
 /**
  * @brief     uart error callback
  * @param[in] *huart pointer to a uart handle
@@ -211,3 +231,45 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
         uart2_set_tx_done();
     }
 }
+
+/**
+ * @brief     spi tx finished callback
+ * @param[in] *hspi pointer to a spi handle
+ * @note      none
+ */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI1)
+    {
+        /* run the spi dma irq handler */
+        spi_dma_irq_handler(0);
+    }
+}
+
+/**
+ * @brief     spi error callback
+ * @param[in] *hspi pointer to a spi handle
+ * @note      none
+ */
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI1)
+    {
+        /* run the spi dma irq handler */
+        spi_dma_irq_handler(1);
+    }
+}
+
+/**
+ * @brief     gpio exti callback
+ * @param[in] pin gpio pin
+ * @note      none
+ */
+void HAL_GPIO_EXTI_Callback(uint16_t pin)
+{
+    if (pin == GPIO_PIN_8)
+    {
+        /* run the wire irq handler */
+        wire_irq_handler();
+    }
+}
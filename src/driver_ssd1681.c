@@ -36,6 +36,7 @@
 
 #include "driver_ssd1681.h"
 #include "driver_ssd1681_font.h"
+#include "driver_ssd1681_waveform.h"
 
 /**
  * @brief chip information definition
@@ -55,6 +56,21 @@
 #define SSD1681_CMD          0        /**< command */
 #define SSD1681_DATA         1        /**< data */
 
+/**
+ * @brief gram plane definition
+ */
+#if (SSD1681_MONOCHROME != 0)
+    #define SSD1681_GRAM(handle, color)    ((void)(color), (handle)->black_gram)        /**< the black gram stands in for the red gram */
+#else
+    #define SSD1681_GRAM(handle, color)    (((color) == SSD1681_COLOR_BLACK) ? (handle)->black_gram : (handle)->red_gram)        /**< gram plane */
+#endif
+
+/**
+ * @brief 3-wire frame definition
+ */
+#define SSD1681_3_WIRE_FRAME_NUM        64                                            /**< frames per transfer, must be a multiple of 8 */
+#define SSD1681_3_WIRE_BUFFER_SIZE      ((SSD1681_3_WIRE_FRAME_NUM * 9) / 8)          /**< packed buffer size */
+
 /**
  * @brief chip command definition
  */
@@ -112,684 +128,809 @@
 #define SSD1681_CMD_NOP                                            0x7F        /**< command nop */
 
 /**
- * @brief     write multiple bytes
+ * @brief display update sequence definition
+ */
+#define SSD1681_SEQUENCE_FULL                0xF7        /**< clock and analog on, load temperature and lut, display, clock and analog off */
+#define SSD1681_SEQUENCE_BURST_START         0xF0        /**< clock and analog on, load temperature and lut */
+#define SSD1681_SEQUENCE_BURST_DISPLAY       0x04        /**< display with the loaded lut */
+#define SSD1681_SEQUENCE_BURST_END           0x03        /**< clock and analog off */
+#define SSD1681_SEQUENCE_SENSE_TEMPERATURE   0xA1        /**< clock on, load temperature, clock off */
+#define SSD1681_SEQUENCE_LOAD_TEMPERATURE    0x20        /**< load temperature with the clock already on */
+#define SSD1681_SEQUENCE_LOAD_LUT            0x10        /**< load the lut from the otp */
+#define SSD1681_SEQUENCE_OTP_MASK            0x30        /**< load temperature and lut, dropped while a lut is written */
+
+/**
+ * @brief busy max timeout definition
+ */
+#define SSD1681_BUSY_MAX_TIMEOUT_MS        (SSD1681_BUSY_MAX_RETRY_TIMES * SSD1681_BUSY_MAX_DELAY_MS)        /**< the same timeout as the poll mode */
+
+/**
+ * @brief shadow register structure definition
+ */
+typedef struct ssd1681_shadow_s
+{
+    uint8_t command;        /**< register command */
+    uint8_t offset;         /**< offset in the shadow buffer */
+    uint8_t len;            /**< register length */
+} ssd1681_shadow_t;
+
+/**
+ * @brief shadow register table definition
+ */
+#define SSD1681_SHADOW_NUM        13        /**< shadow register number */
+static const ssd1681_shadow_t gsc_ssd1681_shadow[SSD1681_SHADOW_NUM] =
+{
+    {SSD1681_CMD_DRIVER_OUTPUT_CONTROL,          0,  3},
+    {SSD1681_CMD_GATE_DRIVING_VOLTAGE_CONTROL,   3,  1},
+    {SSD1681_CMD_SOURCE_DRIVING_VOLTAGE_CONTROL, 4,  3},
+    {SSD1681_CMD_BOOSTER_SOFT_START_CONTROL,     7,  4},
+    {SSD1681_CMD_DATA_ENTRY_MODE_SETTING,        11, 1},
+    {SSD1681_CMD_TEMPERATURE_SENSOR_CONTROL,     12, 1},
+    {SSD1681_CMD_DISPLAY_UPDATA_CONTROL_1,       13, 1},
+    {SSD1681_CMD_DISPLAY_UPDATA_CONTROL_2,       14, 1},
+    {SSD1681_CMD_WRITE_VCOM_REGISTER,            15, 1},
+    {SSD1681_CMD_BORDER_WAVEFORM_CONTROL,        16, 1},
+    {SSD1681_CMD_END_OPTION,                     17, 1},
+    {SSD1681_CMD_SET_RAM_X,                      18, 2},
+    {SSD1681_CMD_SET_RAM_Y,                      20, 4},
+};
+
+/**
+ * @brief full panel ram window
+ */
+static const uint8_t gsc_ssd1681_full_window[6] =
+{
+    0x00, 0x18, 0xC7, 0x00, 0x00, 0x00,
+};
+
+/**
+ * @brief auto write step size table
+ */
+static const uint8_t gsc_ssd1681_step[6] =
+{
+    8, 16, 32, 64, 128, 200,
+};
+
+/**
+ * @brief     write bytes in the command or data phase
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] command set command
+ * @param[in] dc command or data
  * @param[in] *data pointer to a data buffer
  * @param[in] len data length
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      in the 4-wire mode the dc gpio is held and the bytes are sent in one transfer
+ *            per SSD1681_SPI_WRITE_CHUNK_SIZE bytes,
+ *            in the 3-wire mode every byte is sent as a 9-bit frame with the dc bit first,
+ *            SSD1681_3_WIRE_FRAME_NUM frames fill whole bytes so no frame is split between two transfers,
+ *            the last transfer of a write ends with len % 8 frames and is padded with 0 bits to a byte,
+ *            the chip drops the padding as a partial frame when the chip select is released
  */
-static uint8_t a_ssd1681_multiple_write_byte(ssd1681_handle_t *handle, uint8_t command, uint8_t *data, uint16_t len)
+static uint8_t a_ssd1681_spi_write(ssd1681_handle_t *handle, uint8_t dc, uint8_t *data, uint16_t len)
 {
-    uint8_t res;
-    uint8_t value;
+    uint8_t buf[SSD1681_3_WIRE_BUFFER_SIZE];
     uint16_t i;
+    uint16_t n;
+    uint16_t pos;
+    uint8_t bits;
+    uint32_t acc;
     
-    value = 1;                                                     /* set value 1 */
-    for (i = 0; i < SSD1681_BUSY_MAX_RETRY_TIMES; i++)             /* SSD1681_BUSY_MAX_RETRY_TIMES times */
+    if (handle->interface == SSD1681_INTERFACE_4_WIRE)                            /* 4-wire */
     {
-        res = handle->busy_gpio_read(&value);                      /* read the busy */
-        if (res != 0)                                              /* check error */
-        {
-            return 1;                                              /* return error */
-        }
-        if (value == 1)                                            /* if busy */
+        if (handle->spi_cmd_data_gpio_write(dc) != 0)                             /* write command or data */
         {
-            handle->delay_ms(SSD1681_BUSY_MAX_DELAY_MS);           /* delay SSD1681_BUSY_MAX_DELAY_MS */
+            return 1;                                                             /* return error */
         }
-        else
+        while (len != 0)                                                          /* write in chunks */
         {
-            break;                                                 /* break */
+            n = (len > SSD1681_SPI_WRITE_CHUNK_SIZE) ? SSD1681_SPI_WRITE_CHUNK_SIZE : len;    /* get the chunk size */
+            if (handle->spi_write_cmd(data, n) != 0)                              /* write command */
+            {
+                return 1;                                                         /* return error */
+            }
+            data += n;                                                            /* next data */
+            len -= n;                                                             /* sub the length */
         }
-    }
-    if (value == 1)                                                /* check the value */
-    {
-        return 1;                                                  /* return error */
+        
+        return 0;                                                                 /* success return 0 */
     }
     
-    res = handle->spi_cmd_data_gpio_write(SSD1681_CMD);            /* write command */
-    if (res != 0)                                                  /* check error */
-    {
-        return 1;                                                  /* return error */
-    }
-    res = handle->spi_write_cmd(&command, 1);                      /* write command */
-    if (res != 0)                                                  /* check error */
-    {
-        return 1;                                                  /* return error */
-    }
-    if (len != 0)                                                  /* check the length */
+    while (len != 0)                                                              /* 3-wire */
     {
-        res = handle->spi_cmd_data_gpio_write(SSD1681_DATA);       /* write data */
-        if (res != 0)                                              /* check error */
+        n = (len > SSD1681_3_WIRE_FRAME_NUM) ? SSD1681_3_WIRE_FRAME_NUM : len;    /* get the frame number */
+        acc = 0;                                                                  /* init 0 */
+        bits = 0;                                                                 /* init 0 */
+        pos = 0;                                                                  /* init 0 */
+        for (i = 0; i < n; i++)                                                   /* pack n frames */
         {
-            return 1;                                              /* return error */
-        }
-        for (i = 0; i < len; i++)                                  /* len times */
-        {
-            if (handle->spi_write_cmd(data + i, 1) != 0)           /* write command */
+            acc = (acc << 9) | ((uint32_t)(dc & 0x01) << 8) | data[i];            /* append the 9-bit frame */
+            bits += 9;                                                            /* add 9 bits */
+            while (bits >= 8)                                                     /* output full bytes */
             {
-                return 1;                                          /* return error */
+                bits -= 8;                                                        /* sub 8 bits */
+                buf[pos++] = (uint8_t)(acc >> bits);                              /* set the byte */
             }
         }
+        if (bits != 0)                                                            /* pad the last byte */
+        {
+            buf[pos++] = (uint8_t)(acc << (8 - bits));                            /* pad with 0 */
+        }
+        if (handle->spi_write_cmd(buf, pos) != 0)                                 /* write the frames */
+        {
+            return 1;                                                             /* return error */
+        }
+        data += n;                                                                /* next data */
+        len -= n;                                                                 /* sub the length */
     }
     
-    return 0;                                                      /* success return 0 */
+    return 0;                                                                     /* success return 0 */
 }
 
 /**
- * @brief      read multiple bytes
+ * @brief      read bytes in the data phase
  * @param[in]  *handle pointer to an ssd1681 handle structure
- * @param[in]  command set command
  * @param[out] *data pointer to a data buffer
  * @param[in]  len data length
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       the 4-wire mode reads in bulk chunks, the 3-wire mode reads byte by byte
  */
-static uint8_t a_ssd1681_multiple_read_byte(ssd1681_handle_t *handle, uint8_t command, uint8_t *data, uint16_t len)
+static uint8_t a_ssd1681_spi_read(ssd1681_handle_t *handle, uint8_t *data, uint16_t len)
 {
-    uint8_t res;
-    uint8_t value;
     uint16_t i;
+    uint16_t n;
     
-    value = 1;                                                     /* set value 1 */
-    for (i = 0; i < SSD1681_BUSY_MAX_RETRY_TIMES; i++)             /* SSD1681_BUSY_MAX_RETRY_TIMES times */
+    if (handle->interface == SSD1681_INTERFACE_4_WIRE)                            /* 4-wire */
     {
-        res = handle->busy_gpio_read(&value);                      /* read the busy */
-        if (res != 0)                                              /* check error */
+        if (handle->spi_cmd_data_gpio_write(SSD1681_DATA) != 0)                   /* write data */
         {
-            return 1;                                              /* return error */
-        }
-        if (value == 1)                                            /* if busy */
-        {
-            handle->delay_ms(SSD1681_BUSY_MAX_DELAY_MS);           /* delay SSD1681_BUSY_MAX_DELAY_MS */
+            return 1;                                                             /* return error */
         }
-        else
+        while (len != 0)                                                          /* read in chunks */
         {
-            break;                                                 /* break */
+            n = (len > SSD1681_SPI_READ_CHUNK_SIZE) ? SSD1681_SPI_READ_CHUNK_SIZE : len;    /* get the chunk size */
+            if (handle->spi_read_cmd(data, n) != 0)                               /* read command */
+            {
+                return 1;                                                         /* return error */
+            }
+            data += n;                                                            /* next data */
+            len -= n;                                                             /* sub the length */
         }
+        
+        return 0;                                                                 /* success return 0 */
     }
-    if (value == 1)                                                /* check the value */
-    {
-        return 1;                                                  /* return error */
-    }
-    
-    res = handle->spi_cmd_data_gpio_write(SSD1681_CMD);            /* write command */
-    if (res != 0)                                                  /* check error */
-    {
-        return 1;                                                  /* return error */
-    }
-    res = handle->spi_write_cmd(&command, 1);                      /* write command */
-    if (res != 0)                                                  /* check error */
-    {
-        return 1;                                                  /* return error */
-    }
-    if (len != 0)                                                  /* check the length */
+    for (i = 0; i < len; i++)                                                     /* 3-wire */
     {
-        res = handle->spi_cmd_data_gpio_write(SSD1681_DATA);       /* write data */
-        if (res != 0)                                              /* check error */
-        {
-            return 1;                                              /* return error */
-        }
-        for (i = 0; i < len; i++)                                  /* len times */
+        if (handle->spi_read_cmd(data + i, 1) != 0)                               /* read command */
         {
-            if (handle->spi_read_cmd(data + i, 1) != 0)            /* read command */
-            {
-                return 1;                                          /* return error */
-            }
+            return 1;                                                             /* return error */
         }
     }
     
-    return 0;                                                      /* success return 0 */
+    return 0;                                                                     /* success return 0 */
 }
 
 /**
- * @brief     set the driver output
+ * @brief     track the operation for the busy prediction
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] mux set mux
- * @param[in] gd bool value
- * @param[in] sm bool value
- * @param[in] tb bool value
- * @return    status code
- *            - 0 success
- *            - 1 set driver output failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 mux is invalid
- * @note      mux can't be over 0x1FF
+ * @param[in] command sent command
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @note      the temperature is only known after it is written or read by the driver
  */
-uint8_t ssd1681_set_driver_output(ssd1681_handle_t *handle, uint16_t mux, ssd1681_bool_t gd, ssd1681_bool_t sm, ssd1681_bool_t tb)
+static void a_ssd1681_busy_track(ssd1681_handle_t *handle, uint8_t command, uint8_t *data, uint16_t len)
 {
-    uint8_t res;
-    uint8_t b;
-    uint8_t buf[3];
+    uint16_t i;
+    uint8_t sum;
     
-    if (handle == NULL)                                                                                       /* check handle */
+    handle->busy_cmd = command;                                                                       /* save the command */
+    if ((command == SSD1681_CMD_DISPLAY_UPDATA_CONTROL_2) && (len != 0))                              /* display sequence */
     {
-        return 2;                                                                                             /* return error */
+        handle->busy_sequence = data[0];                                                              /* save the sequence */
     }
-    if (handle->inited != 1)                                                                                  /* check handle initialization */
+    else if (command == SSD1681_CMD_WRITE_LUT_REGISTER)                                               /* lut */
     {
-        return 3;                                                                                             /* return error */
+        sum = 0;                                                                                      /* init 0 */
+        for (i = 0; i < len; i++)                                                                     /* len times */
+        {
+            sum = (uint8_t)((sum << 1) | (sum >> 7)) ^ data[i];                                       /* rotate and xor */
+        }
+        handle->busy_lut = sum;                                                                       /* save the lut */
     }
-    if (mux > 0x1FF)                                                                                          /* check mux */
+    else if (((command == SSD1681_CMD_TEMPERATURE_SENSOR_CONTROL_WRITE) ||
+              (command == SSD1681_CMD_TEMPERATURE_SENSOR_CONTROL_READ)) && (len != 0))                /* temperature */
     {
-        handle->debug_print("ssd1681: mux is invalid.\n");                                                    /* mux is invalid */
-        
-        return 4;                                                                                             /* return error */
+        handle->busy_temperature = (int8_t)((int8_t)data[0] / SSD1681_BUSY_PREDICT_TEMP_STEP);        /* save the band */
     }
+}
+
+/**
+ * @brief     get the busy prediction key of the last operation
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    prediction key
+ * @note      the display sequence only matters for the master activation
+ */
+static uint32_t a_ssd1681_busy_key(ssd1681_handle_t *handle)
+{
+    uint32_t key;
     
-    buf[0] = (mux >> 0) & 0xFF;                                                                               /* set mux */
-    buf[1] = (mux >> 8) & 0x01;                                                                               /* set mux */
-    b = 0;                                                                                                    /* init 0 */
-    if (gd != 0)                                                                                              /* check the gd */
-    {
-        b |= 1 << 2;                                                                                          /* set the gd */
-    }
-    if (sm != 0)                                                                                              /* check the sm */
+    key = (uint32_t)handle->busy_cmd << 24;                        /* set the command */
+    if (handle->busy_cmd == SSD1681_CMD_MASTER_ACTIVATION)         /* if master activation */
     {
-        b |= 1 << 1;                                                                                          /* set the sm */
-    }
-    if (tb != 0)                                                                                              /* check the tb */
-    {
-        b |= 1 << 0;                                                                                          /* set the tb */
-    }
-    buf[2] = b;                                                                                               /* set the b */
-  
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DRIVER_OUTPUT_CONTROL, (uint8_t *)buf, 3);        /* write byte */
-    if (res != 0)                                                                                             /* check the result */
-    {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                        /* multiple write byte failed */
-        
-        return 1;                                                                                             /* return error */
+        key |= (uint32_t)handle->busy_sequence << 16;              /* set the display sequence */
+        key |= (uint32_t)handle->busy_lut << 8;                    /* set the lut */
+        key |= (uint32_t)(uint8_t)handle->busy_temperature;        /* set the temperature band */
     }
     
-    return 0;                                                                                                 /* success return 0 */
+    return key;                                                    /* return the key */
 }
 
 /**
- * @brief     set the gate driving voltage
+ * @brief     find the busy prediction
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] voltage gate driving voltage
- * @return    status code
- *            - 0 success
- *            - 1 set gate driving voltage failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ * @param[in] key prediction key
+ * @return    prediction index, SSD1681_BUSY_PREDICT_NUM means not found
  * @note      none
  */
-uint8_t ssd1681_set_gate_driving_voltage(ssd1681_handle_t *handle, ssd1681_gate_driving_voltage_t voltage)
+static uint8_t a_ssd1681_busy_find(ssd1681_handle_t *handle, uint32_t key)
 {
-    uint8_t res;
-    uint8_t buf[1];
+    uint8_t i;
     
-    if (handle == NULL)                                                                                              /* check handle */
+    for (i = 0; i < SSD1681_BUSY_PREDICT_NUM; i++)                                               /* search the table */
     {
-        return 2;                                                                                                    /* return error */
+        if ((handle->busy_predict[i].valid != 0) && (handle->busy_predict[i].key == key))        /* check the key */
+        {
+            break;                                                                               /* break */
+        }
     }
-    if (handle->inited != 1)                                                                                         /* check handle initialization */
+    
+    return i;                                                                                    /* return the index */
+}
+
+/**
+ * @brief     learn the busy time
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] key prediction key
+ * @param[in] ms measured busy time
+ * @note      the prediction is a moving average with a weight of 1/4 for the new sample
+ */
+static void a_ssd1681_busy_learn(ssd1681_handle_t *handle, uint32_t key, uint32_t ms)
+{
+    uint8_t i;
+    
+    i = a_ssd1681_busy_find(handle, key);                                                          /* find the key */
+    if (i == SSD1681_BUSY_PREDICT_NUM)                                                             /* if not found */
     {
-        return 3;                                                                                                    /* return error */
+        i = handle->busy_predict_next;                                                             /* replace the oldest */
+        handle->busy_predict_next = (uint8_t)((i + 1) % SSD1681_BUSY_PREDICT_NUM);                 /* next index */
+        handle->busy_predict[i].key = key;                                                         /* set the key */
+        handle->busy_predict[i].ms = (uint16_t)ms;                                                 /* set the time */
+        handle->busy_predict[i].valid = 1;                                                         /* set valid */
     }
-    
-    buf[0] = voltage;                                                                                                /* set the voltage */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_GATE_DRIVING_VOLTAGE_CONTROL, (uint8_t *)buf, 1);        /* write byte */
-    if (res != 0)                                                                                                    /* check the result */
+    else
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                               /* multiple write byte failed */
-        
-        return 1;                                                                                                    /* return error */
+        handle->busy_predict[i].ms = (uint16_t)((handle->busy_predict[i].ms * 3 + ms) / 4);        /* update the average */
     }
-    
-    return 0;                                                                                                        /* success return 0 */
 }
 
 /**
- * @brief     set the source driving voltage
+ * @brief     wait until the chip is not busy
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] vsh1 set vsh1
- * @param[in] vsh2 set vsh2
- * @param[in] vsl set vsl
  * @return    status code
  *            - 0 success
- *            - 1 set source driving voltage failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      vsh1 >= vsh2
+ *            - 1 wait failed
+ * @note      in the irq mode the core sleeps in busy_gpio_wait until the busy falling edge or the timeout,
+ *            in the poll mode a measured operation sleeps most of its predicted time in one delay
+ *            and then polls every SSD1681_BUSY_FINE_DELAY_MS, an unknown operation is polled
+ *            every SSD1681_BUSY_MAX_DELAY_MS and its busy time is learned,
+ *            an operation already done at the first poll after the sleep can not be measured,
+ *            so its prediction is halved to catch up with an operation that got faster
  */
-uint8_t ssd1681_set_source_driving_voltage(ssd1681_handle_t *handle, ssd1681_vsh_t vsh1, ssd1681_vsh_t vsh2, ssd1681_vsl_t vsl)
+static uint8_t a_ssd1681_busy_wait(ssd1681_handle_t *handle)
 {
     uint8_t res;
-    uint8_t buf[3];
+    uint8_t value;
+    uint8_t i;
+    uint32_t key;
+    uint32_t step;
+    uint32_t elapsed;
+    uint32_t slept;
     
-    if (handle == NULL)                                                                                              /* check handle */
+    value = 1;                                                                                        /* set value 1 */
+    res = handle->busy_gpio_read(&value);                                                             /* read the busy */
+    if (res != 0)                                                                                     /* check error */
     {
-        return 2;                                                                                                    /* return error */
+        return 1;                                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                                                         /* check handle initialization */
+    if (value == 0)                                                                                   /* if not busy */
     {
-        return 3;                                                                                                    /* return error */
+        return 0;                                                                                     /* success return 0 */
     }
     
-    buf[0] = vsh1;                                                                                                   /* set vsh1 */
-    buf[1] = vsh2;                                                                                                   /* set vsh2 */
-    buf[2] = vsl;                                                                                                    /* set vsl */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SOURCE_DRIVING_VOLTAGE_CONTROL, (uint8_t *)buf, 3);      /* write byte */
-    if (res != 0)                                                                                                    /* check the result */
+    if (handle->busy_mode == SSD1681_BUSY_MODE_IRQ)                                                   /* irq mode */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                               /* multiple write byte failed */
+        res = handle->busy_gpio_wait(SSD1681_BUSY_MAX_TIMEOUT_MS);                                    /* wait the falling edge */
+        if (res != 0)                                                                                 /* check error */
+        {
+            return 1;                                                                                 /* return error */
+        }
+        res = handle->busy_gpio_read(&value);                                                         /* read the busy */
+        if (res != 0)                                                                                 /* check error */
+        {
+            return 1;                                                                                 /* return error */
+        }
         
-        return 1;                                                                                                    /* return error */
+        return (value == 0) ? 0 : 1;                                                                  /* return the result */
     }
     
-    return 0;                                                                                                        /* success return 0 */
+    key = a_ssd1681_busy_key(handle);                                                                 /* get the key */
+    i = a_ssd1681_busy_find(handle, key);                                                             /* find the prediction */
+    elapsed = 0;                                                                                      /* init 0 */
+    slept = 0;                                                                                        /* init 0 */
+    step = SSD1681_BUSY_MAX_DELAY_MS;                                                                 /* coarse poll */
+    if (i != SSD1681_BUSY_PREDICT_NUM)                                                                /* if predicted */
+    {
+        if (handle->busy_predict[i].ms > SSD1681_BUSY_PREDICT_GUARD_MS)                               /* check the time */
+        {
+            elapsed = handle->busy_predict[i].ms - SSD1681_BUSY_PREDICT_GUARD_MS;                     /* most of the time */
+            handle->delay_ms(elapsed);                                                                /* sleep in one call */
+            slept = elapsed;                                                                          /* save the sleep time */
+        }
+        step = SSD1681_BUSY_FINE_DELAY_MS;                                                            /* fine poll */
+    }
+    while (elapsed < SSD1681_BUSY_MAX_TIMEOUT_MS)                                                     /* check the timeout */
+    {
+        res = handle->busy_gpio_read(&value);                                                         /* read the busy */
+        if (res != 0)                                                                                 /* check error */
+        {
+            return 1;                                                                                 /* return error */
+        }
+        if (value == 0)                                                                               /* if not busy */
+        {
+            if ((slept != 0) && (elapsed == slept))                                                   /* done before the first poll */
+            {
+                handle->busy_predict[i].ms /= 2;                                                      /* overestimated, halve it */
+            }
+            else
+            {
+                a_ssd1681_busy_learn(handle, key, elapsed);                                           /* learn the time */
+            }
+            
+            return 0;                                                                                 /* success return 0 */
+        }
+        handle->delay_ms(step);                                                                       /* delay step */
+        elapsed += step;                                                                              /* add the time */
+    }
+    
+    return 1;                                                                                         /* return error */
 }
 
 /**
- * @brief     initial code setting otp program
- * @param[in] *handle pointer to an ssd1681 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 otp initial failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ * @brief     find the shadow register
+ * @param[in] command register command
+ * @return    shadow index, SSD1681_SHADOW_NUM means not shadowed
  * @note      none
  */
-uint8_t ssd1681_otp_initial(ssd1681_handle_t *handle)
+static uint8_t a_ssd1681_shadow_find(uint8_t command)
 {
-    uint8_t res;
+    uint8_t i;
     
-    if (handle == NULL)                                                                                      /* check handle */
+    for (i = 0; i < SSD1681_SHADOW_NUM; i++)                  /* check all */
     {
-        return 2;                                                                                            /* return error */
-    }
-    if (handle->inited != 1)                                                                                 /* check handle initialization */
-    {
-        return 3;                                                                                            /* return error */
-    }
-    
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_INITIAL_CODE_SETTING_OTP_PROGRAM, NULL, 0);      /* write byte */
-    if (res != 0)                                                                                            /* check the result */
-    {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                       /* multiple write byte failed */
-        
-        return 1;                                                                                            /* return error */
+        if (gsc_ssd1681_shadow[i].command == command)         /* if found */
+        {
+            break;                                            /* break */
+        }
     }
     
-    return 0;                                                                                                /* success return 0 */
+    return i;                                                 /* return the index */
 }
 
 /**
- * @brief     write register for initial code setting
+ * @brief     check the shadow registers before a write
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] *param pointer to a param buffer
+ * @param[in] command set command
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
  * @return    status code
- *            - 0 success
- *            - 1 otp initial write failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ *            - 0 write is needed
+ *            - 1 register already holds the data
+ * @note      the shadow is dropped before the write, so a failed write leaves it invalid,
+ *            a display sequence that loads the lut from the otp drops the loaded lut,
+ *            a written lut is flagged so that the driver sequences stop loading the otp lut
  */
-uint8_t ssd1681_otp_initial_write(ssd1681_handle_t *handle, uint8_t param[4])
+static uint8_t a_ssd1681_shadow_check(ssd1681_handle_t *handle, uint8_t command, uint8_t *data, uint16_t len)
 {
-    uint8_t res;
+    uint8_t i;
     
-    if (handle == NULL)                                                                                                /* check handle */
+    if ((command == SSD1681_CMD_SW_RESET) ||
+        ((command == SSD1681_CMD_DEEP_SLEEP_MODE) && (len != 0) && (data[0] != 0)))                     /* reset or deep sleep */
+    {
+        handle->shadow_valid = 0;                                                                       /* drop all registers */
+        handle->lut = NULL;                                                                             /* drop the lut */
+        handle->lut_loaded = 0;                                                                         /* the lut register is lost */
+        handle->staged = 0;                                                                             /* the ram may be lost */
+        handle->ram_clear = 0;                                                                          /* the ram is unknown */
+        handle->ram_hash_valid = 0;                                                                     /* drop the ram hash */
+        handle->diff_valid = 0;                                                                         /* drop the last frame */
+        handle->sleeping = (command == SSD1681_CMD_DEEP_SLEEP_MODE) ? 1 : 0;                            /* save the sleep */
+        
+        return 0;                                                                                       /* write */
+    }
+    if ((command == SSD1681_CMD_LOAD_WS_OTP) ||
+        ((command == SSD1681_CMD_DISPLAY_UPDATA_CONTROL_2) && (len != 0) && ((data[0] & 0x10) != 0)))   /* lut from the otp */
     {
-        return 2;                                                                                                      /* return error */
+        handle->lut = NULL;                                                                             /* drop the lut */
+        handle->lut_loaded = 0;                                                                         /* the otp lut is loaded */
+        handle->lut_saved = NULL;                                                                       /* the otp lut is reloaded anyway */
     }
-    if (handle->inited != 1)                                                                                           /* check handle initialization */
+    if (command == SSD1681_CMD_WRITE_LUT_REGISTER)                                                      /* lut is written */
     {
-        return 3;                                                                                                      /* return error */
+        handle->lut_loaded = 1;                                                                         /* keep it on the refresh */
     }
-    
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_REGISTER_FOR_INITIAL_CODE_SETTING, param, 4);        /* write byte */
-    if (res != 0)                                                                                                      /* check the result */
+    if ((command == SSD1681_CMD_WRITE_RAM_BLACK) || 
+        (command == SSD1681_CMD_AUTO_WRITE_BW_RAM_FOR_REGULAR_PATTERN))                                 /* black ram is written */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                                 /* multiple write byte failed */
-        
-        return 1;                                                                                                      /* return error */
+        handle->ram_clear &= (uint8_t)(~(1 << SSD1681_COLOR_BLACK));                                    /* drop the clear flag */
+        handle->ram_hash_valid &= (uint8_t)(~(1 << SSD1681_COLOR_BLACK));                               /* drop the ram hash */
+        handle->diff_valid &= (uint8_t)(~(1 << SSD1681_COLOR_BLACK));                                   /* drop the last frame */
+    }
+    if ((command == SSD1681_CMD_WRITE_RAM_RED) || 
+        (command == SSD1681_CMD_AUTO_WRITE_RED_RAM_FOR_REGULAR_PATTERN))                                /* red ram is written */
+    {
+        handle->ram_clear &= (uint8_t)(~(1 << SSD1681_COLOR_RED));                                      /* drop the clear flag */
+        handle->ram_hash_valid &= (uint8_t)(~(1 << SSD1681_COLOR_RED));                                 /* drop the ram hash */
+        handle->diff_valid &= (uint8_t)(~(1 << SSD1681_COLOR_RED));                                     /* drop the last frame */
+    }
+    i = a_ssd1681_shadow_find(command);                                                                 /* find the register */
+    if (i == SSD1681_SHADOW_NUM)                                                                        /* not shadowed */
+    {
+        return 0;                                                                                       /* write */
+    }
+    if (((handle->shadow_valid & (1U << i)) != 0) && (len == gsc_ssd1681_shadow[i].len) &&
+        (memcmp(&handle->shadow[gsc_ssd1681_shadow[i].offset], data, len) == 0))                        /* unchanged */
+    {
+        return 1;                                                                                       /* skip */
     }
+    handle->shadow_valid &= (uint16_t)(~(1U << i));                                                     /* drop the register */
+    handle->shadow_saved &= (uint16_t)(~(1U << i));                                                     /* drop the saved data */
     
-    return 0;                                                                                                          /* success return 0 */
+    return 0;                                                                                           /* write */
 }
 
 /**
- * @brief     read register for initial code setting
+ * @brief     save the shadow register after a write
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 otp initial read failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @param[in] command set command
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @note      the resume replays the registers from the shadow itself, so the copy is skipped
+ *            when the data already is the shadow entry
  */
-uint8_t ssd1681_otp_initial_read(ssd1681_handle_t *handle)
+static void a_ssd1681_shadow_save(ssd1681_handle_t *handle, uint8_t command, uint8_t *data, uint16_t len)
 {
-    uint8_t res;
+    uint8_t i;
     
-    if (handle == NULL)                                                                                             /* check handle */
+    i = a_ssd1681_shadow_find(command);                                                  /* find the register */
+    if ((i == SSD1681_SHADOW_NUM) || (len != gsc_ssd1681_shadow[i].len))                 /* not shadowed */
     {
-        return 2;                                                                                                   /* return error */
+        return;                                                                          /* return */
     }
-    if (handle->inited != 1)                                                                                        /* check handle initialization */
+    if (data != &handle->shadow[gsc_ssd1681_shadow[i].offset])                           /* not replayed from the shadow */
     {
-        return 3;                                                                                                   /* return error */
+        memcpy(&handle->shadow[gsc_ssd1681_shadow[i].offset], data, len);                /* save the data */
     }
-    
-    res = a_ssd1681_multiple_read_byte(handle, SSD1681_CMD_READ_REGISTER_FOR_INITIAL_CODE_SETTING, NULL, 0);        /* read byte */
-    if (res != 0)                                                                                                   /* check the result */
-    {
-        handle->debug_print("ssd1681: multiple read byte failed.\n");                                               /* multiple read byte failed */
-        
-        return 1;                                                                                                   /* return error */
+    handle->shadow_valid |= (uint16_t)(1U << i);                                         /* flag valid */
+    handle->shadow_saved |= (uint16_t)(1U << i);                                         /* flag saved */
+}
+
+/**
+ * @brief     check if a command starts an internal operation
+ * @param[in] command command
+ * @return    status code
+ *            - 0 the busy pin stays low
+ *            - 1 the busy pin goes high
+ * @note      none
+ */
+static uint8_t a_ssd1681_busy_command(uint8_t command)
+{
+    switch (command)                                                   /* check the command */
+    {
+        case SSD1681_CMD_INITIAL_CODE_SETTING_OTP_PROGRAM :
+        case SSD1681_CMD_SW_RESET :
+        case SSD1681_CMD_HV_READY_DETECTION :
+        case SSD1681_CMD_VCI_DETECTION :
+        case SSD1681_CMD_MASTER_ACTIVATION :
+        case SSD1681_CMD_VCOM_SENSE :
+        case SSD1681_CMD_PROGRAM_VCOM_OTP :
+        case SSD1681_CMD_PROGRAM_WS_OTP :
+        case SSD1681_CMD_LOAD_WS_OTP :
+        case SSD1681_CMD_CRC_CALCULATION :
+        case SSD1681_CMD_PROGRAM_OTP_SELECTION :
+        case SSD1681_CMD_AUTO_WRITE_RED_RAM_FOR_REGULAR_PATTERN :
+        case SSD1681_CMD_AUTO_WRITE_BW_RAM_FOR_REGULAR_PATTERN :
+        {
+            return 1;                                                  /* busy */
+        }
+        default :
+        {
+            return 0;                                                  /* not busy */
+        }
     }
-    
-    return 0;                                                                                                       /* success return 0 */
 }
 
 /**
- * @brief     set the booster soft start
+ * @brief     write a command and its data without the busy check
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] phase1 phase 1
- * @param[in] phase2 phase 2
- * @param[in] phase3 phase 3
- * @param[in] duration phase duration
+ * @param[in] command set command
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
  * @return    status code
  *            - 0 success
- *            - 1 set booster soft start failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ *            - 1 write failed
  * @note      none
  */
-uint8_t ssd1681_set_booster_soft_start(ssd1681_handle_t *handle, 
-                                       uint8_t phase1, uint8_t phase2,
-                                       uint8_t phase3, uint8_t duration)
+static uint8_t a_ssd1681_command_write(ssd1681_handle_t *handle, uint8_t command, uint8_t *data, uint16_t len)
 {
     uint8_t res;
-    uint8_t buf[4];
     
-    if (handle == NULL)                                                                                 /* check handle */
+    res = a_ssd1681_spi_write(handle, SSD1681_CMD, &command, 1);   /* write command */
+    if (res != 0)                                                  /* check error */
     {
-        return 2;                                                                                       /* return error */
+        return 1;                                                  /* return error */
     }
-    if (handle->inited != 1)                                                                            /* check handle initialization */
+    if (len != 0)                                                  /* check the length */
     {
-        return 3;                                                                                       /* return error */
+        res = a_ssd1681_spi_write(handle, SSD1681_DATA, data, len);/* write data */
+        if (res != 0)                                              /* check error */
+        {
+            return 1;                                              /* return error */
+        }
     }
+    a_ssd1681_shadow_save(handle, command, data, len);             /* save the shadow */
+    a_ssd1681_busy_track(handle, command, data, len);              /* track the operation */
     
-    buf[0] = 0x80 | phase1;                                                                             /* set the phase1 */
-    buf[1] = 0x80 | phase2;                                                                             /* set the phase2 */
-    buf[2] = 0x80 | phase3;                                                                             /* set the phase3 */
-    buf[3] = duration;                                                                                  /* set the duration */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_BOOSTER_SOFT_START_CONTROL, buf, 4);        /* write byte */
-    if (res != 0)                                                                                       /* check the result */
+    return 0;                                                      /* success return 0 */
+}
+
+/**
+ * @brief     wake the chip before a bus access
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 wake failed
+ * @note      the chip is only woken when the power manager is enabled,
+ *            the resume clears the sleep flag before it writes, so it does not wake again
+ */
+static uint8_t a_ssd1681_power_wake(ssd1681_handle_t *handle)
+{
+    handle->power_idle = 0;                                                 /* restart the idle time */
+    if ((handle->sleeping == 0) || (handle->power_enable == 0))             /* check the sleep */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                  /* multiple write byte failed */
+        return 0;                                                           /* success return 0 */
+    }
+    if (ssd1681_resume(handle) != 0)                                        /* resume */
+    {
+        handle->debug_print("ssd1681: resume failed.\n");                   /* resume failed */
         
-        return 1;                                                                                       /* return error */
+        return 1;                                                           /* return error */
     }
+    handle->power_wake_count++;                                             /* count the wake */
     
-    return 0;                                                                                           /* success return 0 */
+    return 0;                                                               /* success return 0 */
 }
 
 /**
- * @brief     set the mode
+ * @brief     write multiple bytes
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] mode set mode
+ * @param[in] command set command
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
  * @return    status code
  *            - 0 success
- *            - 1 set mode failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ *            - 1 write failed
  * @note      none
  */
-uint8_t ssd1681_set_mode(ssd1681_handle_t *handle, ssd1681_mode_t mode)
+static uint8_t a_ssd1681_multiple_write_byte(ssd1681_handle_t *handle, uint8_t command, uint8_t *data, uint16_t len)
 {
     uint8_t res;
-    uint8_t buf[1];
     
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle->dma_busy != 0)                                     /* check the dma */
     {
-        return 2;                                                                            /* return error */
+        return 1;                                                  /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (a_ssd1681_power_wake(handle) != 0)                         /* wake the chip */
     {
-        return 3;                                                                            /* return error */
+        return 1;                                                  /* return error */
     }
-    
-    buf[0] = mode;                                                                           /* set the mode */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DEEP_SLEEP_MODE, buf, 1);        /* write byte */
-    if (res != 0)                                                                            /* check the result */
+    if (a_ssd1681_shadow_check(handle, command, data, len) != 0)   /* check the shadow */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                       /* multiple write byte failed */
-        
-        return 1;                                                                            /* return error */
+        return 0;                                                  /* unchanged return 0 */
+    }
+    res = a_ssd1681_busy_wait(handle);                             /* wait the busy */
+    if (res != 0)                                                  /* check error */
+    {
+        return 1;                                                  /* return error */
     }
     
-    return 0;                                                                                /* success return 0 */
+    return a_ssd1681_command_write(handle, command, data, len);    /* write the command */
 }
 
 /**
- * @brief     set the data entry mode
- * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] mode address mode
- * @param[in] direction address direction
- * @return    status code
- *            - 0 success
- *            - 1 set data entry mode failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      read multiple bytes
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[in]  command set command
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
  */
-uint8_t ssd1681_set_data_entry_mode(ssd1681_handle_t *handle, ssd1681_address_mode_t mode, ssd1681_address_direction_t direction)
+static uint8_t a_ssd1681_multiple_read_byte(ssd1681_handle_t *handle, uint8_t command, uint8_t *data, uint16_t len)
 {
     uint8_t res;
-    uint8_t buf[1];
     
-    if (handle == NULL)                                                                              /* check handle */
+    if (handle->dma_busy != 0)                                     /* check the dma */
     {
-        return 2;                                                                                    /* return error */
+        return 1;                                                  /* return error */
     }
-    if (handle->inited != 1)                                                                         /* check handle initialization */
+    if (a_ssd1681_power_wake(handle) != 0)                         /* wake the chip */
     {
-        return 3;                                                                                    /* return error */
+        return 1;                                                  /* return error */
     }
-    
-    buf[0] = (uint8_t)((mode << 0) | (direction << 2));                                              /* set the config */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DATA_ENTRY_MODE_SETTING, buf, 1);        /* write byte */
-    if (res != 0)                                                                                    /* check the result */
+    res = a_ssd1681_busy_wait(handle);                             /* wait the busy */
+    if (res != 0)                                                  /* check error */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                               /* multiple write byte failed */
-        
-        return 1;                                                                                    /* return error */
+        return 1;                                                  /* return error */
+    }
+    res = a_ssd1681_spi_write(handle, SSD1681_CMD, &command, 1);   /* write command */
+    if (res != 0)                                                  /* check error */
+    {
+        return 1;                                                  /* return error */
+    }
+    if (len != 0)                                                  /* check the length */
+    {
+        res = a_ssd1681_spi_read(handle, data, len);               /* read data */
+        if (res != 0)                                              /* check error */
+        {
+            return 1;                                              /* return error */
+        }
     }
+    a_ssd1681_busy_track(handle, command, data, len);              /* track the operation */
     
-    return 0;                                                                                        /* success return 0 */
+    return 0;                                                      /* success return 0 */
 }
 
 /**
- * @brief     software reset
+ * @brief     run a display update sequence
  * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] sequence display update control 2 value
  * @return    status code
  *            - 0 success
- *            - 1 software reset failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ *            - 1 run failed
+ * @note      the otp temperature and lut loads are dropped while a written lut is in the lut register,
+ *            otherwise the refresh would replace the lut loaded by the driver
  */
-uint8_t ssd1681_software_reset(ssd1681_handle_t *handle)
+static uint8_t a_ssd1681_run_sequence(ssd1681_handle_t *handle, uint8_t sequence)
 {
     uint8_t res;
     
-    if (handle == NULL)                                                                /* check handle */
+    if ((handle->lut_loaded != 0) && ((sequence & SSD1681_SEQUENCE_LOAD_LUT) != 0))                    /* keep the written lut */
     {
-        return 2;                                                                      /* return error */
+        sequence &= (uint8_t)(~SSD1681_SEQUENCE_OTP_MASK);                                             /* 0xF7 -> 0xC7, 0xF0 -> 0xC0 */
     }
-    if (handle->inited != 1)                                                           /* check handle initialization */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DISPLAY_UPDATA_CONTROL_2, &sequence, 1);   /* write byte */
+    if (res != 0)                                                                                      /* check the result */
     {
-        return 3;                                                                      /* return error */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        
+        return 1;                                                                                      /* return error */
     }
-    
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SW_RESET, NULL, 0);        /* write byte */
-    if (res != 0)                                                                      /* check the result */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_MASTER_ACTIVATION, NULL, 0);               /* write byte */
+    if (res != 0)                                                                                      /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                 /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
         
-        return 1;                                                                      /* return error */
+        return 1;                                                                                      /* return error */
     }
     
-    return 0;                                                                          /* success return 0 */
+    return 0;                                                                                          /* success return 0 */
 }
 
 /**
- * @brief     set the hv ready detection
+ * @brief     load a lut unless it is already loaded
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] cool_down_duration cool down duration 
- * @param[in] cool_down_loop_num cool down loop num
+ * @param[in] *lut pointer to a lut
+ * @param[in] len lut length
  * @return    status code
  *            - 0 success
- *            - 1 set hv ready detection failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 cool_down_duration is over 7
- *            - 5 cool_down_loop_num is over 7
- * @note      cool_down_duration <= 7
- *            cool_down_loop_num <= 7
- *            duration = 10ms x (cool_down_duration + 1)
+ *            - 1 load failed
+ * @note      none
  */
-uint8_t ssd1681_set_hv_ready_detection(ssd1681_handle_t *handle, uint8_t cool_down_duration, uint8_t cool_down_loop_num)
+static uint8_t a_ssd1681_load_lut(ssd1681_handle_t *handle, const uint8_t *lut, uint16_t len)
 {
     uint8_t res;
-    uint8_t buf[1];
     
-    if (handle == NULL)                                                                         /* check handle */
-    {
-        return 2;                                                                               /* return error */
-    }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
+    if (lut == handle->lut)                                                                  /* already loaded */
     {
-        return 3;                                                                               /* return error */
+        return 0;                                                                            /* success return 0 */
     }
-    if (cool_down_duration > 0x7)                                                               /* check the cool_down_duration */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_LUT_REGISTER,
+                                        (uint8_t *)lut, len);                                /* write byte */
+    if (res != 0)                                                                            /* check the result */
     {
-        handle->debug_print("ssd1681: cool_down_duration is over 7.\n");                        /* cool_down_duration is over 7 */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                       /* multiple write byte failed */
+        handle->lut = NULL;                                                                  /* unknown lut */
         
-        return 4;                                                                               /* return error */
-    }
-    if (cool_down_loop_num > 0x7)                                                               /* check the cool_down_loop_num */
-    {
-        handle->debug_print("ssd1681: cool_down_loop_num is over 7.\n");                        /* cool_down_loop_num is over 7 */
-        
-        return 5;                                                                               /* return error */
-    }
-    
-    buf[0] = (cool_down_duration << 4) | (cool_down_loop_num << 0);                             /* set the config */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_HV_READY_DETECTION, buf, 1);        /* write byte */
-    if (res != 0)                                                                               /* check the result */
-    {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                          /* multiple write byte failed */
-        
-        return 1;                                                                               /* return error */
+        return 1;                                                                            /* return error */
     }
+    handle->lut = lut;                                                                       /* save the lut */
+    handle->lut_saved = lut;                                                                 /* save for the resume */
+    handle->lut_saved_len = len;                                                             /* save the length */
     
-    return 0;                                                                                   /* success return 0 */
+    return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief     set the vci detection
+ * @brief     pulse the reset and wait until the chip is ready
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] level vci level
  * @return    status code
  *            - 0 success
- *            - 1 set vci detection failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ *            - 1 reset failed
+ * @note      the busy pin rises shortly after the reset is released and is high until the chip has booted,
+ *            so the wait starts after SSD1681_RESET_RELEASE_MS, the boot time is learned
+ *            under the deep sleep command because a wake up is a hardware reset
  */
-uint8_t ssd1681_set_vci_detection(ssd1681_handle_t *handle, ssd1681_vci_level_t level)
+static uint8_t a_ssd1681_hardware_reset(ssd1681_handle_t *handle)
 {
-    uint8_t res;
-    uint8_t buf[1];
-    
-    if (handle == NULL)                                                                    /* check handle */
-    {
-        return 2;                                                                          /* return error */
-    }
-    if (handle->inited != 1)                                                               /* check handle initialization */
-    {
-        return 3;                                                                          /* return error */
-    }
-    
-    buf[0] = level;                                                                        /* set the level */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_VCI_DETECTION, buf, 1);        /* write byte */
-    if (res != 0)                                                                          /* check the result */
+    if (handle->reset_gpio_write(0) != 0)                                      /* write 0 */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                     /* multiple write byte failed */
+        handle->debug_print("ssd1681: reset gpio write failed.\n");            /* reset gpio write failed */
         
-        return 1;                                                                          /* return error */
-    }
-    
-    return 0;                                                                              /* success return 0 */
-}
-
-/**
- * @brief     set the temperature sensor
- * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] sensor temperature sensor
- * @return    status code
- *            - 0 success
- *            - 1 set temperature sensor failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t ssd1681_set_temperature_sensor(ssd1681_handle_t *handle, ssd1681_temperature_sensor_t sensor)
-{
-    uint8_t res;
-    uint8_t buf[1];
-    
-    if (handle == NULL)                                                                                 /* check handle */
-    {
-        return 2;                                                                                       /* return error */
+        return 1;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                                            /* check handle initialization */
+    handle->delay_ms(SSD1681_RESET_PULSE_MS);                                  /* hold the reset */
+    if (handle->reset_gpio_write(1) != 0)                                      /* write 1 */
     {
-        return 3;                                                                                       /* return error */
+        handle->debug_print("ssd1681: reset gpio write failed.\n");            /* reset gpio write failed */
+        
+        return 1;                                                              /* return error */
     }
-    
-    buf[0] = sensor;                                                                                    /* set the temperature sensor */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_TEMPERATURE_SENSOR_CONTROL, buf, 1);        /* write byte */
-    if (res != 0)                                                                                       /* check the result */
+    handle->delay_ms(SSD1681_RESET_RELEASE_MS);                                /* wait the busy to rise */
+    handle->busy_cmd = SSD1681_CMD_DEEP_SLEEP_MODE;                            /* learn the boot time */
+    if (a_ssd1681_busy_wait(handle) != 0)                                      /* wait the busy */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                  /* multiple write byte failed */
+        handle->debug_print("ssd1681: busy wait failed.\n");                   /* busy wait failed */
         
-        return 1;                                                                                       /* return error */
+        return 1;                                                              /* return error */
     }
     
-    return 0;                                                                                           /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief     write the temperature sensor
+ * @brief     set the driver output
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] control set control
+ * @param[in] mux set mux
+ * @param[in] gd bool value
+ * @param[in] sm bool value
+ * @param[in] tb bool value
  * @return    status code
  *            - 0 success
- *            - 1 write temperature sensor failed
+ *            - 1 set driver output failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 control is over 0xFFF
- * @note      none
+ *            - 4 mux is invalid
+ * @note      mux can't be over 0x1FF
  */
-uint8_t ssd1681_write_temperature_sensor(ssd1681_handle_t *handle, uint16_t control)
+uint8_t ssd1681_set_driver_output(ssd1681_handle_t *handle, uint16_t mux, ssd1681_bool_t gd, ssd1681_bool_t sm, ssd1681_bool_t tb)
 {
     uint8_t res;
-    uint8_t buf[2];
+    uint8_t b;
+    uint8_t buf[3];
     
     if (handle == NULL)                                                                                       /* check handle */
     {
@@ -799,16 +940,31 @@ uint8_t ssd1681_write_temperature_sensor(ssd1681_handle_t *handle, uint16_t cont
     {
         return 3;                                                                                             /* return error */
     }
-    if (control > 0xFFF)                                                                                      /* check the control */
+    if (mux > 0x1FF)                                                                                          /* check mux */
     {
-        handle->debug_print("ssd1681: control is over 0xFFF.\n");                                             /* control is over 0xFFF */
+        handle->debug_print("ssd1681: mux is invalid.\n");                                                    /* mux is invalid */
         
         return 4;                                                                                             /* return error */
     }
     
-    buf[0] = (control >> 4) & 0xFF;                                                                           /* set the temperature data */
-    buf[1] = ((control >> 0) << 4) & 0xFF;                                                                    /* set the temperature data */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_TEMPERATURE_SENSOR_CONTROL_WRITE, buf, 2);        /* write byte */
+    buf[0] = (mux >> 0) & 0xFF;                                                                               /* set mux */
+    buf[1] = (mux >> 8) & 0x01;                                                                               /* set mux */
+    b = 0;                                                                                                    /* init 0 */
+    if (gd != 0)                                                                                              /* check the gd */
+    {
+        b |= 1 << 2;                                                                                          /* set the gd */
+    }
+    if (sm != 0)                                                                                              /* check the sm */
+    {
+        b |= 1 << 1;                                                                                          /* set the sm */
+    }
+    if (tb != 0)                                                                                              /* check the tb */
+    {
+        b |= 1 << 0;                                                                                          /* set the tb */
+    }
+    buf[2] = b;                                                                                               /* set the b */
+  
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DRIVER_OUTPUT_CONTROL, (uint8_t *)buf, 3);        /* write byte */
     if (res != 0)                                                                                             /* check the result */
     {
         handle->debug_print("ssd1681: multiple write byte failed.\n");                                        /* multiple write byte failed */
@@ -820,337 +976,369 @@ uint8_t ssd1681_write_temperature_sensor(ssd1681_handle_t *handle, uint16_t cont
 }
 
 /**
- * @brief      read the temperature sensor
- * @param[in]  *handle pointer to an ssd1681 handle structure
- * @param[out] *control pointer to a control buffer
- * @return     status code
- *             - 0 success
- *             - 1 read temperature sensor failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     set the gate driving voltage
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] voltage gate driving voltage
+ * @return    status code
+ *            - 0 success
+ *            - 1 set gate driving voltage failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t ssd1681_read_temperature_sensor(ssd1681_handle_t *handle, uint16_t *control)
+uint8_t ssd1681_set_gate_driving_voltage(ssd1681_handle_t *handle, ssd1681_gate_driving_voltage_t voltage)
 {
     uint8_t res;
-    uint8_t buf[2];
+    uint8_t buf[1];
     
-    if (handle == NULL)                                                                                     /* check handle */
+    if (handle == NULL)                                                                                              /* check handle */
     {
-        return 2;                                                                                           /* return error */
+        return 2;                                                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                                                /* check handle initialization */
+    if (handle->inited != 1)                                                                                         /* check handle initialization */
     {
-        return 3;                                                                                           /* return error */
+        return 3;                                                                                                    /* return error */
     }
     
-    res = a_ssd1681_multiple_read_byte(handle, SSD1681_CMD_TEMPERATURE_SENSOR_CONTROL_READ, buf, 2);        /* read byte */
-    if (res != 0)                                                                                           /* check the result */
+    buf[0] = voltage;                                                                                                /* set the voltage */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_GATE_DRIVING_VOLTAGE_CONTROL, (uint8_t *)buf, 1);        /* write byte */
+    if (res != 0)                                                                                                    /* check the result */
     {
-        handle->debug_print("ssd1681: multiple read byte failed.\n");                                       /* multiple read byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                               /* multiple write byte failed */
         
-        return 1;                                                                                           /* return error */
+        return 1;                                                                                                    /* return error */
     }
-    *control = (((uint16_t)buf[0]) << 4) | ((buf[1] >> 4) & 0xFF);                                          /* set the control */
     
-    return 0;                                                                                               /* success return 0 */
+    return 0;                                                                                                        /* success return 0 */
 }
 
 /**
- * @brief     write command to external temperature sensor
+ * @brief     set the source driving voltage
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] *param pointer to a param buffer
+ * @param[in] vsh1 set vsh1
+ * @param[in] vsh2 set vsh2
+ * @param[in] vsl set vsl
  * @return    status code
  *            - 0 success
- *            - 1 write temperature sensor ext failed
+ *            - 1 set source driving voltage failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      vsh1 >= vsh2
  */
-uint8_t ssd1681_write_temperature_sensor_ext(ssd1681_handle_t *handle, uint8_t param[3])
+uint8_t ssd1681_set_source_driving_voltage(ssd1681_handle_t *handle, ssd1681_vsh_t vsh1, ssd1681_vsh_t vsh2, ssd1681_vsl_t vsl)
 {
     uint8_t res;
+    uint8_t buf[3];
     
-    if (handle == NULL)                                                                                             /* check handle */
+    if (handle == NULL)                                                                                              /* check handle */
     {
-        return 2;                                                                                                   /* return error */
+        return 2;                                                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                                                        /* check handle initialization */
+    if (handle->inited != 1)                                                                                         /* check handle initialization */
     {
-        return 3;                                                                                                   /* return error */
+        return 3;                                                                                                    /* return error */
     }
     
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_TEMPERATURE_SENSOR_CONTROL_WRITE_EXT, param, 3);        /* write byte */
-    if (res != 0)                                                                                                   /* check the result */
+    buf[0] = vsh1;                                                                                                   /* set vsh1 */
+    buf[1] = vsh2;                                                                                                   /* set vsh2 */
+    buf[2] = vsl;                                                                                                    /* set vsl */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SOURCE_DRIVING_VOLTAGE_CONTROL, (uint8_t *)buf, 3);      /* write byte */
+    if (res != 0)                                                                                                    /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                              /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                               /* multiple write byte failed */
         
-        return 1;                                                                                                   /* return error */
+        return 1;                                                                                                    /* return error */
     }
     
-    return 0;                                                                                                       /* success return 0 */
+    return 0;                                                                                                        /* success return 0 */
 }
 
 /**
- * @brief     master activate
+ * @brief     initial code setting otp program
  * @param[in] *handle pointer to an ssd1681 handle structure
  * @return    status code
  *            - 0 success
- *            - 1 set master activate failed
+ *            - 1 otp initial failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_set_master_activate(ssd1681_handle_t *handle)
+uint8_t ssd1681_otp_initial(ssd1681_handle_t *handle)
 {
     uint8_t res;
     
-    if (handle == NULL)                                                                         /* check handle */
+    if (handle == NULL)                                                                                      /* check handle */
     {
-        return 2;                                                                               /* return error */
+        return 2;                                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                                                 /* check handle initialization */
     {
-        return 3;                                                                               /* return error */
+        return 3;                                                                                            /* return error */
     }
     
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_MASTER_ACTIVATION, NULL, 0);        /* write byte */
-    if (res != 0)                                                                               /* check the result */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_INITIAL_CODE_SETTING_OTP_PROGRAM, NULL, 0);      /* write byte */
+    if (res != 0)                                                                                            /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                          /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                       /* multiple write byte failed */
         
-        return 1;                                                                               /* return error */
+        return 1;                                                                                            /* return error */
     }
     
-    return 0;                                                                                   /* success return 0 */
+    return 0;                                                                                                /* success return 0 */
 }
 
 /**
- * @brief     set the display update control
+ * @brief     write register for initial code setting
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] red_control red control
- * @param[in] black_control black control
+ * @param[in] *param pointer to a param buffer
  * @return    status code
  *            - 0 success
- *            - 1 set display update control failed
+ *            - 1 otp initial write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_set_display_update_control(ssd1681_handle_t *handle, ssd1681_display_control_t red_control, ssd1681_display_control_t black_control)
+uint8_t ssd1681_otp_initial_write(ssd1681_handle_t *handle, uint8_t param[4])
 {
     uint8_t res;
-    uint8_t buf[1];
     
-    if (handle == NULL)                                                                               /* check handle */
+    if (handle == NULL)                                                                                                /* check handle */
     {
-        return 2;                                                                                     /* return error */
+        return 2;                                                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                                          /* check handle initialization */
+    if (handle->inited != 1)                                                                                           /* check handle initialization */
     {
-        return 3;                                                                                     /* return error */
+        return 3;                                                                                                      /* return error */
     }
     
-    buf[0] = (uint8_t)((red_control << 4) | (black_control << 0));                                    /* set the display update control */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DISPLAY_UPDATA_CONTROL_1, buf, 1);        /* write byte */
-    if (res != 0)                                                                                     /* check the result */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_REGISTER_FOR_INITIAL_CODE_SETTING, param, 4);        /* write byte */
+    if (res != 0)                                                                                                      /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                                 /* multiple write byte failed */
         
-        return 1;                                                                                     /* return error */
+        return 1;                                                                                                      /* return error */
     }
     
-    return 0;                                                                                         /* success return 0 */
+    return 0;                                                                                                          /* success return 0 */
 }
 
 /**
- * @brief     set the display sequence
+ * @brief     read register for initial code setting
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] sequence display sequence
  * @return    status code
  *            - 0 success
- *            - 1 set display sequence failed
+ *            - 1 otp initial read failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_set_display_sequence(ssd1681_handle_t *handle, ssd1681_display_sequence_t sequence)
+uint8_t ssd1681_otp_initial_read(ssd1681_handle_t *handle)
 {
     uint8_t res;
-    uint8_t buf[1];
     
-    if (handle == NULL)                                                                               /* check handle */
+    if (handle == NULL)                                                                                             /* check handle */
     {
-        return 2;                                                                                     /* return error */
+        return 2;                                                                                                   /* return error */
     }
-    if (handle->inited != 1)                                                                          /* check handle initialization */
+    if (handle->inited != 1)                                                                                        /* check handle initialization */
     {
-        return 3;                                                                                     /* return error */
+        return 3;                                                                                                   /* return error */
     }
     
-    buf[0] = sequence;                                                                                /* set the display sequence */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DISPLAY_UPDATA_CONTROL_2, buf, 1);        /* write byte */
-    if (res != 0)                                                                                     /* check the result */
+    res = a_ssd1681_multiple_read_byte(handle, SSD1681_CMD_READ_REGISTER_FOR_INITIAL_CODE_SETTING, NULL, 0);        /* read byte */
+    if (res != 0)                                                                                                   /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple read byte failed.\n");                                               /* multiple read byte failed */
         
-        return 1;                                                                                     /* return error */
+        return 1;                                                                                                   /* return error */
     }
     
-    return 0;                                                                                         /* success return 0 */
+    return 0;                                                                                                       /* success return 0 */
 }
 
 /**
- * @brief     set the black ram
+ * @brief     set the booster soft start
  * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] phase1 phase 1
+ * @param[in] phase2 phase 2
+ * @param[in] phase3 phase 3
+ * @param[in] duration phase duration
  * @return    status code
  *            - 0 success
- *            - 1 set black ram failed
+ *            - 1 set booster soft start failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_set_black_ram(ssd1681_handle_t *handle)
+uint8_t ssd1681_set_booster_soft_start(ssd1681_handle_t *handle, 
+                                       uint8_t phase1, uint8_t phase2,
+                                       uint8_t phase3, uint8_t duration)
 {
     uint8_t res;
+    uint8_t buf[4];
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                                 /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                                            /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                                       /* return error */
     }
     
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_RAM_BLACK, NULL, 0);        /* write byte */
-    if (res != 0)                                                                             /* check the result */
+    buf[0] = 0x80 | phase1;                                                                             /* set the phase1 */
+    buf[1] = 0x80 | phase2;                                                                             /* set the phase2 */
+    buf[2] = 0x80 | phase3;                                                                             /* set the phase3 */
+    buf[3] = duration;                                                                                  /* set the duration */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_BOOSTER_SOFT_START_CONTROL, buf, 4);        /* write byte */
+    if (res != 0)                                                                                       /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                        /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                  /* multiple write byte failed */
         
-        return 1;                                                                             /* return error */
+        return 1;                                                                                       /* return error */
     }
     
-    return 0;                                                                                 /* success return 0 */
+    return 0;                                                                                           /* success return 0 */
 }
 
 /**
- * @brief     set the red ram
+ * @brief     set the mode
  * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] mode set mode
  * @return    status code
  *            - 0 success
- *            - 1 set red ram failed
+ *            - 1 set mode failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_set_red_ram(ssd1681_handle_t *handle)
+uint8_t ssd1681_set_mode(ssd1681_handle_t *handle, ssd1681_mode_t mode)
 {
     uint8_t res;
+    uint8_t buf[1];
     
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                                                                      /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    if (handle->inited != 1)                                                                 /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                                                                            /* return error */
     }
     
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_RAM_RED, NULL, 0);        /* write byte */
-    if (res != 0)                                                                           /* check the result */
+    buf[0] = mode;                                                                           /* set the mode */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DEEP_SLEEP_MODE, buf, 1);        /* write byte */
+    if (res != 0)                                                                            /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                      /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                       /* multiple write byte failed */
         
-        return 1;                                                                           /* return error */
+        return 1;                                                                            /* return error */
     }
     
-    return 0;                                                                               /* success return 0 */
+    return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief     get the ram
+ * @brief     wake up from the deep sleep and restore the configuration
  * @param[in] *handle pointer to an ssd1681 handle structure
  * @return    status code
  *            - 0 success
- *            - 1 get ram failed
+ *            - 1 resume failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 reset failed
+ * @note      the last written configuration registers and the last lut loaded by
+ *            ssd1681_select_lut or ssd1681_use_waveform are written again,
+ *            a lut written by ssd1681_set_lut_register is not restored,
+ *            the display update control 2 is not replayed so that a stale otp load can not drop the lut
  */
-uint8_t ssd1681_get_ram(ssd1681_handle_t *handle)
+uint8_t ssd1681_resume(ssd1681_handle_t *handle)
 {
     uint8_t res;
+    uint8_t i;
     
-    if (handle == NULL)                                                                /* check handle */
+    if (handle == NULL)                                                                               /* check handle */
     {
-        return 2;                                                                      /* return error */
+        return 2;                                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                           /* check handle initialization */
+    if (handle->inited != 1)                                                                          /* check handle initialization */
     {
-        return 3;                                                                      /* return error */
+        return 3;                                                                                     /* return error */
     }
-    
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_READ_RAM, NULL, 0);        /* write byte */
-    if (res != 0)                                                                      /* check the result */
+    if (handle->dma_busy != 0)                                                                        /* check the dma */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                 /* multiple write byte failed */
+        handle->debug_print("ssd1681: dma is busy.\n");                                               /* dma is busy */
         
-        return 1;                                                                      /* return error */
+        return 1;                                                                                     /* return error */
     }
     
-    return 0;                                                                          /* success return 0 */
-}
-
-/**
- * @brief     set enter vcom sense
- * @param[in] *handle pointer to an ssd1681 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 set enter vcom sense failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t ssd1681_set_enter_vcom_sense(ssd1681_handle_t *handle)
-{
-    uint8_t res;
+    handle->shadow_valid = 0;                                                                         /* the registers are lost by the reset */
+    handle->lut = NULL;                                                                               /* the lut is lost by the reset */
+    handle->lut_loaded = 0;                                                                           /* the lut register is lost */
+    handle->staged = 0;                                                                               /* the ram may be lost */
+    if (a_ssd1681_hardware_reset(handle) != 0)                                                        /* hardware reset */
+    {
+        return 4;                                                                                     /* return error */
+    }
+    handle->sleeping = 0;                                                                             /* the chip is awake */
     
-    if (handle == NULL)                                                                  /* check handle */
+    for (i = 0; i < SSD1681_SHADOW_NUM; i++)                                                          /* replay the registers */
     {
-        return 2;                                                                        /* return error */
+        if (((handle->shadow_saved & (1U << i)) != 0) &&
+            (gsc_ssd1681_shadow[i].command != SSD1681_CMD_DISPLAY_UPDATA_CONTROL_2))                  /* written by each refresh */
+        {
+            res = a_ssd1681_multiple_write_byte(handle, gsc_ssd1681_shadow[i].command, 
+                                                &handle->shadow[gsc_ssd1681_shadow[i].offset],
+                                                gsc_ssd1681_shadow[i].len);                           /* write byte */
+            if (res != 0)                                                                             /* check the result */
+            {
+                handle->debug_print("ssd1681: multiple write byte failed.\n");                        /* multiple write byte failed */
+                
+                return 1;                                                                             /* return error */
+            }
+        }
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->lut_saved != NULL)                                                                    /* if a lut is saved */
     {
-        return 3;                                                                        /* return error */
+        res = a_ssd1681_load_lut(handle, handle->lut_saved, handle->lut_saved_len);                   /* load the lut */
+        if (res != 0)                                                                                 /* check the result */
+        {
+            return 1;                                                                                 /* return error */
+        }
     }
-    
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_VCOM_SENSE, NULL, 0);        /* write byte */
-    if (res != 0)                                                                        /* check the result */
+    if (handle->burst != 0)                                                                           /* if burst */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                   /* multiple write byte failed */
-        
-        return 1;                                                                        /* return error */
+        res = a_ssd1681_run_sequence(handle, SSD1681_SEQUENCE_BURST_START);                           /* power up again */
+        if (res != 0)                                                                                 /* check the result */
+        {
+            handle->debug_print("ssd1681: run sequence failed.\n");                                   /* run sequence failed */
+            
+            return 1;                                                                                 /* return error */
+        }
     }
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                                         /* success return 0 */
 }
 
 /**
- * @brief     set the vcom sense duration
+ * @brief     run an init table
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] duration vcom sense duration
+ * @param[in] *table pointer to an init record table
+ * @param[in] num record number
  * @return    status code
  *            - 0 success
- *            - 1 set vcom sense duration failed
+ *            - 1 run init table failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      vcom sense duration = (duration + 1) sec
+ *            - 4 table is invalid
+ * @note      the busy pin is checked once before the table and again only after
+ *            a record that starts an internal operation such as the software reset
  */
-uint8_t ssd1681_set_vcom_sense_duration(ssd1681_handle_t *handle, uint8_t duration)
+uint8_t ssd1681_run_init_table(ssd1681_handle_t *handle, const ssd1681_init_record_t *table, uint16_t num)
 {
     uint8_t res;
-    uint8_t buf[1];
+    uint8_t wait;
+    uint16_t i;
     
     if (handle == NULL)                                                                          /* check handle */
     {
@@ -1160,245 +1348,253 @@ uint8_t ssd1681_set_vcom_sense_duration(ssd1681_handle_t *handle, uint8_t durati
     {
         return 3;                                                                                /* return error */
     }
-    
-    buf[0] = duration;                                                                           /* set the duration */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_VCOM_SENSE_DURATION, buf, 1);        /* write byte */
-    if (res != 0)                                                                                /* check the result */
+    if ((table == NULL) && (num != 0))                                                           /* check the table */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                           /* multiple write byte failed */
+        handle->debug_print("ssd1681: table is null.\n");                                        /* table is null */
+        
+        return 4;                                                                                /* return error */
+    }
+    for (i = 0; i < num; i++)                                                                    /* check all records */
+    {
+        if (table[i].len > SSD1681_INIT_RECORD_MAX_LEN)                                          /* check the length */
+        {
+            handle->debug_print("ssd1681: record %d is invalid.\n", i);                          /* record is invalid */
+            
+            return 4;                                                                            /* return error */
+        }
+    }
+    if (handle->dma_busy != 0)                                                                   /* check the dma */
+    {
+        handle->debug_print("ssd1681: dma is busy.\n");                                          /* dma is busy */
         
         return 1;                                                                                /* return error */
     }
+    if (a_ssd1681_power_wake(handle) != 0)                                                       /* wake the chip */
+    {
+        return 1;                                                                                /* return error */
+    }
+    
+    wait = 1;                                                                                    /* check once first */
+    for (i = 0; i < num; i++)                                                                    /* run all records */
+    {
+        if (a_ssd1681_shadow_check(handle, table[i].command, 
+                                   (uint8_t *)table[i].data, table[i].len) != 0)                 /* unchanged */
+        {
+            continue;                                                                            /* skip */
+        }
+        if (wait != 0)                                                                           /* if busy is possible */
+        {
+            res = a_ssd1681_busy_wait(handle);                                                   /* wait the busy */
+            if (res != 0)                                                                        /* check the result */
+            {
+                handle->debug_print("ssd1681: busy wait failed.\n");                             /* busy wait failed */
+                
+                return 1;                                                                        /* return error */
+            }
+        }
+        res = a_ssd1681_command_write(handle, table[i].command, 
+                                      (uint8_t *)table[i].data, table[i].len);                   /* write the record */
+        if (res != 0)                                                                            /* check the result */
+        {
+            handle->debug_print("ssd1681: command write failed.\n");                             /* command write failed */
+            
+            return 1;                                                                            /* return error */
+        }
+        wait = a_ssd1681_busy_command(table[i].command);                                         /* check the next time */
+    }
     
     return 0;                                                                                    /* success return 0 */
 }
 
 /**
- * @brief     program vcom otp
+ * @brief     enable or disable the power manager
  * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 otp program vcom failed
+ *            - 1 set power manager failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      when enabled, every driver function that accesses the bus wakes the chip from the deep sleep first,
+ *            the raw ssd1681_write_cmd, ssd1681_write_data and ssd1681_read_data do not wake it
  */
-uint8_t ssd1681_otp_program_vcom(ssd1681_handle_t *handle)
+uint8_t ssd1681_set_power_manager(ssd1681_handle_t *handle, ssd1681_bool_t enable)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                                        /* check handle */
+    if (handle == NULL)                             /* check handle */
     {
-        return 2;                                                                              /* return error */
+        return 2;                                   /* return error */
     }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
+    if (handle->inited != 1)                        /* check handle initialization */
     {
-        return 3;                                                                              /* return error */
+        return 3;                                   /* return error */
     }
     
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_PROGRAM_VCOM_OTP, NULL, 0);        /* write byte */
-    if (res != 0)                                                                              /* check the result */
-    {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                         /* multiple write byte failed */
-        
-        return 1;                                                                              /* return error */
-    }
+    handle->power_enable = (uint8_t)enable;         /* set the power manager */
+    handle->power_idle = 0;                         /* restart the idle time */
     
-    return 0;                                                                                  /* success return 0 */
+    return 0;                                       /* success return 0 */
 }
 
 /**
- * @brief     write register for vcom control
- * @param[in] *handle pointer to an ssd1681 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 set vcom control reg failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      get the power manager status
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get power manager failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t ssd1681_set_vcom_control_reg(ssd1681_handle_t *handle)
+uint8_t ssd1681_get_power_manager(ssd1681_handle_t *handle, ssd1681_bool_t *enable)
 {
-    uint8_t res;
-    uint8_t buf[2];
-    
-    if (handle == NULL)                                                                                      /* check handle */
+    if (handle == NULL)                                          /* check handle */
     {
-        return 2;                                                                                            /* return error */
+        return 2;                                                /* return error */
     }
-    if (handle->inited != 1)                                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                     /* check handle initialization */
     {
-        return 3;                                                                                            /* return error */
+        return 3;                                                /* return error */
     }
     
-    buf[0] = 0x04;                                                                                           /* command 1 */
-    buf[1] = 0x63;                                                                                           /* command 2 */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_REGISTER_FOR_VCOM_CONTROL, buf, 2);        /* write byte */
-    if (res != 0)                                                                                            /* check the result */
-    {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                       /* multiple write byte failed */
-        
-        return 1;                                                                                            /* return error */
-    }
+    *enable = (ssd1681_bool_t)(handle->power_enable);            /* get the power manager */
     
-    return 0;                                                                                                /* success return 0 */
+    return 0;                                                    /* success return 0 */
 }
 
 /**
- * @brief     write vcom register
+ * @brief     set the idle time before the deep sleep
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] vcom set vcom
+ * @param[in] ms idle time in ms
  * @return    status code
  *            - 0 success
- *            - 1 set vcom register failed
+ *            - 1 set power idle time failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the idle time starts after the last upload or activation
  */
-uint8_t ssd1681_set_vcom_register(ssd1681_handle_t *handle, ssd1681_vcom_t vcom)
+uint8_t ssd1681_set_power_idle_time(ssd1681_handle_t *handle, uint32_t ms)
 {
-    uint8_t res;
-    uint8_t buf[1];
-    
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                          /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                     /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                /* return error */
     }
     
-    buf[0] = vcom;                                                                               /* set the vcom */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_VCOM_REGISTER, buf, 1);        /* write byte */
-    if (res != 0)                                                                                /* check the result */
-    {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                           /* multiple write byte failed */
-        
-        return 1;                                                                                /* return error */
-    }
+    handle->power_idle_time = ms;                /* set the idle time */
     
-    return 0;                                                                                    /* success return 0 */
+    return 0;                                    /* success return 0 */
 }
 
 /**
- * @brief      otp register read for display option
+ * @brief      get the idle time before the deep sleep
  * @param[in]  *handle pointer to an ssd1681 handle structure
- * @param[out] *param pointer to a param buffer
+ * @param[out] *ms pointer to an idle time buffer
  * @return     status code
  *             - 0 success
- *             - 1 otp read register failed
+ *             - 1 get power idle time failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t ssd1681_otp_read_register(ssd1681_handle_t *handle, uint8_t param[11])
+uint8_t ssd1681_get_power_idle_time(ssd1681_handle_t *handle, uint32_t *ms)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                                                             /* check handle */
+    if (handle == NULL)                          /* check handle */
     {
-        return 2;                                                                                                   /* return error */
+        return 2;                                /* return error */
     }
-    if (handle->inited != 1)                                                                                        /* check handle initialization */
+    if (handle->inited != 1)                     /* check handle initialization */
     {
-        return 3;                                                                                                   /* return error */
+        return 3;                                /* return error */
     }
     
-    res = a_ssd1681_multiple_read_byte(handle, SSD1681_CMD_OTP_REGISTER_READ_FOR_DISPLAY_OPTION, param, 11);        /* read byte */
-    if (res != 0)                                                                                                   /* check the result */
-    {
-        handle->debug_print("ssd1681: multiple read byte failed.\n");                                               /* multiple read byte failed */
-        
-        return 1;                                                                                                   /* return error */
-    }
+    *ms = handle->power_idle_time;               /* get the idle time */
     
-    return 0;                                                                                                       /* success return 0 */
+    return 0;                                    /* success return 0 */
 }
 
 /**
- * @brief      get the user id
- * @param[in]  *handle pointer to an ssd1681 handle structure
- * @param[out] *id pointer to an id buffer
- * @return     status code
- *             - 0 success
- *             - 1 get user id failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     set the deep sleep mode used by the power manager
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] mode deep sleep mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set power sleep mode failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 mode is invalid
+ * @note      the ram is lost in the deep sleep mode 2 and the gram must be uploaded again
  */
-uint8_t ssd1681_get_user_id(ssd1681_handle_t *handle, uint8_t id[10])
+uint8_t ssd1681_set_power_sleep_mode(ssd1681_handle_t *handle, ssd1681_mode_t mode)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                   /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                         /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                              /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                         /* return error */
     }
-    
-    res = a_ssd1681_multiple_read_byte(handle, SSD1681_CMD_USER_ID_READ, id, 10);        /* read byte */
-    if (res != 0)                                                                        /* check the result */
+    if ((mode != SSD1681_MODE_DEEP_SLEEP_1) &&
+        (mode != SSD1681_MODE_DEEP_SLEEP_2))                              /* check the mode */
     {
-        handle->debug_print("ssd1681: multiple read byte failed.\n");                    /* multiple read byte failed */
+        handle->debug_print("ssd1681: mode is invalid.\n");               /* mode is invalid */
         
-        return 1;                                                                        /* return error */
+        return 4;                                                         /* return error */
     }
     
-    return 0;                                                                            /* success return 0 */
+    handle->power_mode = (uint8_t)mode;                                   /* set the mode */
+    
+    return 0;                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the status
+ * @brief      get the deep sleep mode used by the power manager
  * @param[in]  *handle pointer to an ssd1681 handle structure
- * @param[out] *status pointer to a status buffer
+ * @param[out] *mode pointer to a deep sleep mode buffer
  * @return     status code
  *             - 0 success
- *             - 1 get status failed
+ *             - 1 get power sleep mode failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t ssd1681_get_status(ssd1681_handle_t *handle, uint8_t *status)
+uint8_t ssd1681_get_power_sleep_mode(ssd1681_handle_t *handle, ssd1681_mode_t *mode)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                                        /* check handle */
+    if (handle == NULL)                                  /* check handle */
     {
-        return 2;                                                                              /* return error */
+        return 2;                                        /* return error */
     }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
+    if (handle->inited != 1)                             /* check handle initialization */
     {
-        return 3;                                                                              /* return error */
+        return 3;                                        /* return error */
     }
     
-    res = a_ssd1681_multiple_read_byte(handle, SSD1681_CMD_STATUS_BIT_READ, status, 1);        /* read byte */
-    if (res != 0)                                                                              /* check the result */
-    {
-        handle->debug_print("ssd1681: multiple read byte failed.\n");                          /* multiple read byte failed */
-        
-        return 1;                                                                              /* return error */
-    }
+    *mode = (ssd1681_mode_t)(handle->power_mode);        /* get the mode */
     
-    return 0;                                                                                  /* success return 0 */
+    return 0;                                            /* success return 0 */
 }
 
 /**
- * @brief     program otp of waveform setting
+ * @brief     run the power manager
  * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] ms time passed since the last call in ms
  * @return    status code
  *            - 0 success
- *            - 1 otp program waveform failed
+ *            - 1 power process failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      call it periodically, the chip enters the deep sleep once the idle time
+ *            has passed and the busy pin is low, the time is also added to the statistics
  */
-uint8_t ssd1681_otp_program_waveform(ssd1681_handle_t *handle)
+uint8_t ssd1681_power_process(ssd1681_handle_t *handle, uint32_t ms)
 {
     uint8_t res;
+    uint8_t value;
+    uint8_t buf[1];
     
     if (handle == NULL)                                                                      /* check handle */
     {
@@ -1409,7 +1605,44 @@ uint8_t ssd1681_otp_program_waveform(ssd1681_handle_t *handle)
         return 3;                                                                            /* return error */
     }
     
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_PROGRAM_WS_OTP, NULL, 0);        /* write byte */
+    if (handle->sleeping != 0)                                                               /* if sleeping */
+    {
+        handle->power_sleep_ms += ms;                                                        /* add the sleep time */
+        
+        return 0;                                                                            /* success return 0 */
+    }
+    handle->power_awake_ms += ms;                                                            /* add the awake time */
+    if (handle->power_enable == 0)                                                           /* check the power manager */
+    {
+        return 0;                                                                            /* success return 0 */
+    }
+    handle->power_idle += ms;                                                                /* add the idle time */
+    if ((handle->power_idle < handle->power_idle_time) || (handle->dma_busy != 0))           /* check the idle time */
+    {
+        return 0;                                                                            /* success return 0 */
+    }
+    if (handle->busy_gpio_read(&value) != 0)                                                 /* read busy pin */
+    {
+        handle->debug_print("ssd1681: busy gpio read failed.\n");                            /* busy gpio read failed */
+        
+        return 1;                                                                            /* return error */
+    }
+    if (value != 0)                                                                          /* still busy */
+    {
+        return 0;                                                                            /* success return 0 */
+    }
+    if (handle->burst != 0)                                                                  /* if burst */
+    {
+        res = a_ssd1681_run_sequence(handle, SSD1681_SEQUENCE_BURST_END);                    /* power down */
+        if (res != 0)                                                                        /* check the result */
+        {
+            handle->debug_print("ssd1681: run sequence failed.\n");                          /* run sequence failed */
+            
+            return 1;                                                                        /* return error */
+        }
+    }
+    buf[0] = handle->power_mode;                                                             /* set the mode */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DEEP_SLEEP_MODE, buf, 1);        /* write byte */
     if (res != 0)                                                                            /* check the result */
     {
         handle->debug_print("ssd1681: multiple write byte failed.\n");                       /* multiple write byte failed */
@@ -1421,1060 +1654,3462 @@ uint8_t ssd1681_otp_program_waveform(ssd1681_handle_t *handle)
 }
 
 /**
- * @brief     load otp of waveform setting
- * @param[in] *handle pointer to an ssd1681 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 otp load waveform failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      get the power manager statistics
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *awake_ms pointer to an awake time buffer
+ * @param[out] *sleep_ms pointer to a sleep time buffer
+ * @param[out] *wake_count pointer to a wake count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get power statistics failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the time is the sum passed to ssd1681_power_process
  */
-uint8_t ssd1681_otp_load_waveform(ssd1681_handle_t *handle)
+uint8_t ssd1681_get_power_statistics(ssd1681_handle_t *handle, uint32_t *awake_ms, uint32_t *sleep_ms, uint32_t *wake_count)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                      /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                           /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                      /* return error */
     }
     
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_LOAD_WS_OTP, NULL, 0);        /* write byte */
-    if (res != 0)                                                                         /* check the result */
-    {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                    /* multiple write byte failed */
-        
-        return 1;                                                                         /* return error */
-    }
+    *awake_ms = handle->power_awake_ms;                /* get the awake time */
+    *sleep_ms = handle->power_sleep_ms;                /* get the sleep time */
+    *wake_count = handle->power_wake_count;            /* get the wake count */
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                          /* success return 0 */
 }
 
 /**
- * @brief     set the lut register
+ * @brief     set the data entry mode
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] *reg pointer to a register buffer
- * @param[in] len register length
+ * @param[in] mode address mode
+ * @param[in] direction address direction
  * @return    status code
  *            - 0 success
- *            - 1 set lut register failed
+ *            - 1 set data entry mode failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_set_lut_register(ssd1681_handle_t *handle, uint8_t *reg, uint16_t len)
+uint8_t ssd1681_set_data_entry_mode(ssd1681_handle_t *handle, ssd1681_address_mode_t mode, ssd1681_address_direction_t direction)
 {
     uint8_t res;
+    uint8_t buf[1];
     
-    if (handle == NULL)                                                                           /* check handle */
+    if (handle == NULL)                                                                              /* check handle */
     {
-        return 2;                                                                                 /* return error */
+        return 2;                                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                                      /* check handle initialization */
+    if (handle->inited != 1)                                                                         /* check handle initialization */
     {
-        return 3;                                                                                 /* return error */
+        return 3;                                                                                    /* return error */
     }
     
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_LUT_REGISTER, reg, len);        /* write byte */
-    if (res != 0)                                                                                 /* check the result */
+    buf[0] = (uint8_t)((mode << 0) | (direction << 2));                                              /* set the config */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DATA_ENTRY_MODE_SETTING, buf, 1);        /* write byte */
+    if (res != 0)                                                                                    /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                            /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                               /* multiple write byte failed */
         
-        return 1;                                                                                 /* return error */
+        return 1;                                                                                    /* return error */
     }
     
-    return 0;                                                                                     /* success return 0 */
+    return 0;                                                                                        /* success return 0 */
 }
 
 /**
- * @brief     set the crc calculation
+ * @brief     software reset
  * @param[in] *handle pointer to an ssd1681 handle structure
  * @return    status code
  *            - 0 success
- *            - 1 set crc calculation failed
+ *            - 1 software reset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_set_crc_calculation(ssd1681_handle_t *handle)
+uint8_t ssd1681_software_reset(ssd1681_handle_t *handle)
 {
     uint8_t res;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                           /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                      /* return error */
     }
     
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_CRC_CALCULATION, NULL, 0);        /* write byte */
-    if (res != 0)                                                                             /* check the result */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SW_RESET, NULL, 0);        /* write byte */
+    if (res != 0)                                                                      /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                        /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                 /* multiple write byte failed */
         
-        return 1;                                                                             /* return error */
+        return 1;                                                                      /* return error */
     }
     
-    return 0;                                                                                 /* success return 0 */
+    return 0;                                                                          /* success return 0 */
 }
 
 /**
- * @brief      get the crc status
- * @param[in]  *handle pointer to an ssd1681 handle structure
- * @param[out] *status pointer to a status buffer
- * @return     status code
- *             - 0 success
- *             - 1 get crc status failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     set the hv ready detection
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] cool_down_duration cool down duration 
+ * @param[in] cool_down_loop_num cool down loop num
+ * @return    status code
+ *            - 0 success
+ *            - 1 set hv ready detection failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 cool_down_duration is over 7
+ *            - 5 cool_down_loop_num is over 7
+ * @note      cool_down_duration <= 7
+ *            cool_down_loop_num <= 7
+ *            duration = 10ms x (cool_down_duration + 1)
  */
-uint8_t ssd1681_get_crc_status(ssd1681_handle_t *handle, uint16_t *status)
+uint8_t ssd1681_set_hv_ready_detection(ssd1681_handle_t *handle, uint8_t cool_down_duration, uint8_t cool_down_loop_num)
 {
     uint8_t res;
-    uint8_t buf[2];
+    uint8_t buf[1];
     
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                                                                               /* return error */
+    }
+    if (cool_down_duration > 0x7)                                                               /* check the cool_down_duration */
+    {
+        handle->debug_print("ssd1681: cool_down_duration is over 7.\n");                        /* cool_down_duration is over 7 */
+        
+        return 4;                                                                               /* return error */
+    }
+    if (cool_down_loop_num > 0x7)                                                               /* check the cool_down_loop_num */
+    {
+        handle->debug_print("ssd1681: cool_down_loop_num is over 7.\n");                        /* cool_down_loop_num is over 7 */
+        
+        return 5;                                                                               /* return error */
     }
     
-    res = a_ssd1681_multiple_read_byte(handle, SSD1681_CMD_CRC_STATUS_READ, buf, 2);        /* read byte */
-    if (res != 0)                                                                           /* check the result */
+    buf[0] = (cool_down_duration << 4) | (cool_down_loop_num << 0);                             /* set the config */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_HV_READY_DETECTION, buf, 1);        /* write byte */
+    if (res != 0)                                                                               /* check the result */
     {
-        handle->debug_print("ssd1681: multiple read byte failed.\n");                       /* multiple read byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                          /* multiple write byte failed */
         
-        return 1;                                                                           /* return error */
+        return 1;                                                                               /* return error */
     }
-    *status = (uint16_t)(buf[0] << 0) | buf[1];                                             /* set the status */
     
-    return 0;                                                                               /* success return 0 */
+    return 0;                                                                                   /* success return 0 */
 }
 
 /**
- * @brief     program otp selection
+ * @brief     set the vci detection
  * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] level vci level
  * @return    status code
  *            - 0 success
- *            - 1 otp program selection failed
+ *            - 1 set vci detection failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_otp_program_selection(ssd1681_handle_t *handle)
+uint8_t ssd1681_set_vci_detection(ssd1681_handle_t *handle, ssd1681_vci_level_t level)
 {
     uint8_t res;
+    uint8_t buf[1];
     
-    if (handle == NULL)                                                                             /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                                   /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                                        /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                                   /* return error */
+        return 3;                                                                          /* return error */
     }
     
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_PROGRAM_OTP_SELECTION, NULL, 0);        /* write byte */
-    if (res != 0)                                                                                   /* check the result */
+    buf[0] = level;                                                                        /* set the level */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_VCI_DETECTION, buf, 1);        /* write byte */
+    if (res != 0)                                                                          /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                              /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                     /* multiple write byte failed */
         
-        return 1;                                                                                   /* return error */
+        return 1;                                                                          /* return error */
     }
     
-    return 0;                                                                                       /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief     otp write register for display option
+ * @brief     set the temperature sensor
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] *param pointer to a param buffer
+ * @param[in] sensor temperature sensor
  * @return    status code
  *            - 0 success
- *            - 1 otp write register failed
+ *            - 1 set temperature sensor failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_otp_write_register(ssd1681_handle_t *handle, uint8_t param[11])
+uint8_t ssd1681_set_temperature_sensor(ssd1681_handle_t *handle, ssd1681_temperature_sensor_t sensor)
 {
     uint8_t res;
+    uint8_t buf[1];
     
-    if (handle == NULL)                                                                                           /* check handle */
+    if (handle == NULL)                                                                                 /* check handle */
     {
-        return 2;                                                                                                 /* return error */
+        return 2;                                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                                                      /* check handle initialization */
+    if (handle->inited != 1)                                                                            /* check handle initialization */
     {
-        return 3;                                                                                                 /* return error */
+        return 3;                                                                                       /* return error */
     }
     
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_REGISTER_FOR_DISPLAY_OPTION, param, 11);        /* write byte */
-    if (res != 0)                                                                                                 /* check the result */
+    buf[0] = sensor;                                                                                    /* set the temperature sensor */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_TEMPERATURE_SENSOR_CONTROL, buf, 1);        /* write byte */
+    if (res != 0)                                                                                       /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                            /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                  /* multiple write byte failed */
         
-        return 1;                                                                                                 /* return error */
+        return 1;                                                                                       /* return error */
     }
     
-    return 0;                                                                                                     /* success return 0 */
+    return 0;                                                                                           /* success return 0 */
 }
 
 /**
- * @brief     set the user id
+ * @brief     write the temperature sensor
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] *id pointer to an id buffer
+ * @param[in] control set control
  * @return    status code
  *            - 0 success
- *            - 1 set user id failed
+ *            - 1 write temperature sensor failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 4 control is over 0xFFF
  * @note      none
  */
-uint8_t ssd1681_set_user_id(ssd1681_handle_t *handle, uint8_t id[10])
+uint8_t ssd1681_write_temperature_sensor(ssd1681_handle_t *handle, uint16_t control)
 {
     uint8_t res;
+    uint8_t buf[2];
     
-    if (handle == NULL)                                                                                 /* check handle */
+    if (handle == NULL)                                                                                       /* check handle */
     {
-        return 2;                                                                                       /* return error */
+        return 2;                                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                                                  /* check handle initialization */
     {
-        return 3;                                                                                       /* return error */
+        return 3;                                                                                             /* return error */
+    }
+    if (control > 0xFFF)                                                                                      /* check the control */
+    {
+        handle->debug_print("ssd1681: control is over 0xFFF.\n");                                             /* control is over 0xFFF */
+        
+        return 4;                                                                                             /* return error */
     }
     
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_REGISTER_FOR_USER_ID, id, 10);        /* write byte */
-    if (res != 0)                                                                                       /* check the result */
+    buf[0] = (control >> 4) & 0xFF;                                                                           /* set the temperature data */
+    buf[1] = ((control >> 0) << 4) & 0xFF;                                                                    /* set the temperature data */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_TEMPERATURE_SENSOR_CONTROL_WRITE, buf, 2);        /* write byte */
+    if (res != 0)                                                                                             /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                  /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                        /* multiple write byte failed */
         
-        return 1;                                                                                       /* return error */
+        return 1;                                                                                             /* return error */
     }
     
-    return 0;                                                                                           /* success return 0 */
+    return 0;                                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set the otp program mode
- * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] mode otp mode
- * @return    status code
- *            - 0 success
- *            - 1 otp program mode failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      read the temperature sensor
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *control pointer to a control buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature sensor failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t ssd1681_otp_program_mode(ssd1681_handle_t *handle, ssd1681_otp_mode_t mode)
+uint8_t ssd1681_read_temperature_sensor(ssd1681_handle_t *handle, uint16_t *control)
 {
     uint8_t res;
-    uint8_t buf[1];
+    uint8_t buf[2];
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                                     /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                                           /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                                                /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                                           /* return error */
     }
     
-    buf[0] = mode;                                                                            /* set the mode */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_OTP_PROGRAM_MODE, buf, 1);        /* write byte */
-    if (res != 0)                                                                             /* check the result */
+    res = a_ssd1681_multiple_read_byte(handle, SSD1681_CMD_TEMPERATURE_SENSOR_CONTROL_READ, buf, 2);        /* read byte */
+    if (res != 0)                                                                                           /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                        /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple read byte failed.\n");                                       /* multiple read byte failed */
         
-        return 1;                                                                             /* return error */
+        return 1;                                                                                           /* return error */
     }
+    *control = (((uint16_t)buf[0]) << 4) | ((buf[1] >> 4) & 0xFF);                                          /* set the control */
     
-    return 0;                                                                                 /* success return 0 */
+    return 0;                                                                                               /* success return 0 */
 }
 
 /**
- * @brief     set the border waveform
+ * @brief     write command to external temperature sensor
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] vbd select vbd option
- * @param[in] level fix level setting for vbd
- * @param[in] gs_tran gs transition control
- * @param[in] vbd_tran gs transition setting for vbd
+ * @param[in] *param pointer to a param buffer
  * @return    status code
  *            - 0 success
- *            - 1 set border waveform failed
+ *            - 1 write temperature sensor ext failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_set_border_waveform(ssd1681_handle_t *handle, ssd1681_vbd_t vbd, ssd1681_vbd_fix_level_t level,
-                                    ssd1681_gs_transition_t gs_tran, ssd1681_vbd_transition_t vbd_tran)
+uint8_t ssd1681_write_temperature_sensor_ext(ssd1681_handle_t *handle, uint8_t param[3])
 {
     uint8_t res;
-    uint8_t buf[1];
     
-    if (handle == NULL)                                                                              /* check handle */
+    if (handle == NULL)                                                                                             /* check handle */
     {
-        return 2;                                                                                    /* return error */
+        return 2;                                                                                                   /* return error */
     }
-    if (handle->inited != 1)                                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                                                        /* check handle initialization */
     {
-        return 3;                                                                                    /* return error */
+        return 3;                                                                                                   /* return error */
     }
     
-    buf[0] = (uint8_t)((vbd << 6) | (level << 4) | (gs_tran << 2) | (vbd_tran << 0));                /* set the mode */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_BORDER_WAVEFORM_CONTROL, buf, 1);        /* write byte */
-    if (res != 0)                                                                                    /* check the result */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_TEMPERATURE_SENSOR_CONTROL_WRITE_EXT, param, 3);        /* write byte */
+    if (res != 0)                                                                                                   /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                               /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                              /* multiple write byte failed */
         
-        return 1;                                                                                    /* return error */
+        return 1;                                                                                                   /* return error */
     }
     
-    return 0;                                                                                        /* success return 0 */
+    return 0;                                                                                                       /* success return 0 */
 }
 
 /**
- * @brief     end option
+ * @brief     master activate
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] opt end option
  * @return    status code
  *            - 0 success
- *            - 1 set end option failed
+ *            - 1 set master activate failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_set_end_option(ssd1681_handle_t *handle, ssd1681_end_opt_t opt)
+uint8_t ssd1681_set_master_activate(ssd1681_handle_t *handle)
 {
     uint8_t res;
-    uint8_t buf[1];
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                               /* return error */
     }
     
-    buf[0] = opt;                                                                       /* set the mode */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_END_OPTION, buf, 1);        /* write byte */
-    if (res != 0)                                                                       /* check the result */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_MASTER_ACTIVATION, NULL, 0);        /* write byte */
+    if (res != 0)                                                                               /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                  /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                          /* multiple write byte failed */
         
-        return 1;                                                                       /* return error */
+        return 1;                                                                               /* return error */
     }
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                                   /* success return 0 */
 }
 
 /**
- * @brief     set the read ram
+ * @brief     set the display update control
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] ram read ram option
+ * @param[in] red_control red control
+ * @param[in] black_control black control
  * @return    status code
  *            - 0 success
- *            - 1 set read ram failed
+ *            - 1 set display update control failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_set_read_ram(ssd1681_handle_t *handle, ssd1681_read_ram_t ram)
+uint8_t ssd1681_set_display_update_control(ssd1681_handle_t *handle, ssd1681_display_control_t red_control, ssd1681_display_control_t black_control)
 {
     uint8_t res;
     uint8_t buf[1];
     
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                                               /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                                          /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                                     /* return error */
     }
     
-    buf[0] = ram;                                                                            /* set the mode */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_READ_RAM_OPTION, buf, 1);        /* write byte */
-    if (res != 0)                                                                            /* check the result */
+    buf[0] = (uint8_t)((red_control << 4) | (black_control << 0));                                    /* set the display update control */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DISPLAY_UPDATA_CONTROL_1, buf, 1);        /* write byte */
+    if (res != 0)                                                                                     /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                       /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                /* multiple write byte failed */
         
-        return 1;                                                                            /* return error */
+        return 1;                                                                                     /* return error */
     }
     
-    return 0;                                                                                /* success return 0 */
+    return 0;                                                                                         /* success return 0 */
 }
 
 /**
- * @brief     set the ram x range
+ * @brief     set the display sequence
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] start start address
- * @param[in] end end address
+ * @param[in] sequence display sequence
  * @return    status code
  *            - 0 success
- *            - 1 set ram x failed
+ *            - 1 set display sequence failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 start > 0x3F
- *            - 5 end > 0x3F
  * @note      none
  */
-uint8_t ssd1681_set_ram_x(ssd1681_handle_t *handle, uint8_t start, uint8_t end)
+uint8_t ssd1681_set_display_sequence(ssd1681_handle_t *handle, ssd1681_display_sequence_t sequence)
 {
     uint8_t res;
-    uint8_t buf[2];
+    uint8_t buf[1];
     
-    if (handle == NULL)                                                                /* check handle */
-    {
-        return 2;                                                                      /* return error */
-    }
-    if (handle->inited != 1)                                                           /* check handle initialization */
-    {
-        return 3;                                                                      /* return error */
-    }
-    if (start > 0x3F)                                                                  /* check the start */
+    if (handle == NULL)                                                                               /* check handle */
     {
-        handle->debug_print("ssd1681: start > 0x3F.\n");                               /* start > 0x3F */
-        
-        return 4;                                                                      /* return error */
+        return 2;                                                                                     /* return error */
     }
-    if (end > 0x3F)                                                                    /* check the end */
+    if (handle->inited != 1)                                                                          /* check handle initialization */
     {
-        handle->debug_print("ssd1681: end > 0x3F.\n");                                 /* end > 0x3F */
-        
-        return 5;                                                                      /* return error */
+        return 3;                                                                                     /* return error */
     }
     
-    buf[0] = start;                                                                    /* set the start address */
-    buf[1] = end;                                                                      /* set the end address */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_X, buf, 2);        /* write byte */
-    if (res != 0)                                                                      /* check the result */
+    buf[0] = sequence;                                                                                /* set the display sequence */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DISPLAY_UPDATA_CONTROL_2, buf, 1);        /* write byte */
+    if (res != 0)                                                                                     /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                 /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                /* multiple write byte failed */
         
-        return 1;                                                                      /* return error */
+        return 1;                                                                                     /* return error */
     }
     
-    return 0;                                                                          /* success return 0 */
+    return 0;                                                                                         /* success return 0 */
 }
 
 /**
- * @brief     set the ram y range
+ * @brief     set the black ram
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] start start address
- * @param[in] end end address
  * @return    status code
  *            - 0 success
- *            - 1 set ram y failed
+ *            - 1 set black ram failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_set_ram_y(ssd1681_handle_t *handle, uint16_t start, uint16_t end)
+uint8_t ssd1681_set_black_ram(ssd1681_handle_t *handle)
 {
     uint8_t res;
-    uint8_t buf[4];
     
-    if (handle == NULL)                                                                /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                      /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                           /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                      /* return error */
+        return 3;                                                                             /* return error */
     }
     
-    buf[0] = start & 0xFF;                                                             /* set the start address */
-    buf[1] = (start >> 8) & 0x1;                                                       /* set the start address */
-    buf[2] = end & 0xFF;                                                               /* set the end address */
-    buf[3] = (end >> 8) & 0x01;                                                        /* set the end address */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_Y, buf, 4);        /* write byte */
-    if (res != 0)                                                                      /* check the result */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_RAM_BLACK, NULL, 0);        /* write byte */
+    if (res != 0)                                                                             /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                 /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                        /* multiple write byte failed */
         
-        return 1;                                                                      /* return error */
+        return 1;                                                                             /* return error */
     }
     
-    return 0;                                                                          /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set the auto write red ram
+ * @brief     set the red ram
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] height step height
- * @param[in] width step width
  * @return    status code
  *            - 0 success
- *            - 1 set auto write red ram failed
+ *            - 1 set red ram failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_set_auto_write_red_ram(ssd1681_handle_t *handle, ssd1681_step_height_t height, ssd1681_step_width_t width)
+uint8_t ssd1681_set_red_ram(ssd1681_handle_t *handle)
 {
     uint8_t res;
-    uint8_t buf[1];
     
-    if (handle == NULL)                                                                                             /* check handle */
+    if (handle == NULL)                                                                     /* check handle */
     {
-        return 2;                                                                                                   /* return error */
+        return 2;                                                                           /* return error */
     }
-    if (handle->inited != 1)                                                                                        /* check handle initialization */
+    if (handle->inited != 1)                                                                /* check handle initialization */
     {
-        return 3;                                                                                                   /* return error */
+        return 3;                                                                           /* return error */
     }
     
-    buf[0] = (uint8_t)((height << 4) | (width << 0));                                                               /* set the param */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_AUTO_WRITE_RED_RAM_FOR_REGULAR_PATTERN, buf, 1);        /* write byte */
-    if (res != 0)                                                                                                   /* check the result */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_RAM_RED, NULL, 0);        /* write byte */
+    if (res != 0)                                                                           /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                              /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                      /* multiple write byte failed */
         
-        return 1;                                                                                                   /* return error */
+        return 1;                                                                           /* return error */
     }
     
-    return 0;                                                                                                       /* success return 0 */
+    return 0;                                                                               /* success return 0 */
 }
 
 /**
- * @brief     set the auto write black ram
+ * @brief     get the ram
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] height step height
- * @param[in] width step width
  * @return    status code
  *            - 0 success
- *            - 1 set auto write black ram failed
+ *            - 1 get ram failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_set_auto_write_black_ram(ssd1681_handle_t *handle, ssd1681_step_height_t height, ssd1681_step_width_t width)
+uint8_t ssd1681_get_ram(ssd1681_handle_t *handle)
 {
     uint8_t res;
-    uint8_t buf[1];
     
-    if (handle == NULL)                                                                                            /* check handle */
+    if (handle == NULL)                                                                /* check handle */
     {
-        return 2;                                                                                                  /* return error */
+        return 2;                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                                                       /* check handle initialization */
+    if (handle->inited != 1)                                                           /* check handle initialization */
     {
-        return 3;                                                                                                  /* return error */
+        return 3;                                                                      /* return error */
     }
     
-    buf[0] = (uint8_t)((height << 4) | (width << 0));                                                              /* set the param */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_AUTO_WRITE_BW_RAM_FOR_REGULAR_PATTERN, buf, 1);        /* write byte */
-    if (res != 0)                                                                                                  /* check the result */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_READ_RAM, NULL, 0);        /* write byte */
+    if (res != 0)                                                                      /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                             /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                 /* multiple write byte failed */
         
-        return 1;                                                                                                  /* return error */
+        return 1;                                                                      /* return error */
     }
     
-    return 0;                                                                                                      /* success return 0 */
+    return 0;                                                                          /* success return 0 */
 }
 
 /**
- * @brief     set the ram x address counter
+ * @brief     set enter vcom sense
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] cnt address counter
  * @return    status code
  *            - 0 success
- *            - 1 set ram x address counter failed
+ *            - 1 set enter vcom sense failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 cnt > 0x3F
  * @note      none
  */
-uint8_t ssd1681_set_ram_x_address_counter(ssd1681_handle_t *handle, uint8_t cnt)
+uint8_t ssd1681_set_enter_vcom_sense(ssd1681_handle_t *handle)
 {
     uint8_t res;
-    uint8_t buf[1];
     
-    if (handle == NULL)                                                                                /* check handle */
-    {
-        return 2;                                                                                      /* return error */
-    }
-    if (handle->inited != 1)                                                                           /* check handle initialization */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 3;                                                                                      /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (cnt > 0x3F)                                                                                    /* check the result */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        handle->debug_print("ssd1681: cnt > 0x3F.\n");                                                 /* cnt > 0x3F */
-        
-        return 4;                                                                                      /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    buf[0] = cnt;                                                                                      /* set the counter */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_X_ADDRESS_COUNTER, buf, 1);        /* write byte */
-    if (res != 0)                                                                                      /* check the result */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_VCOM_SENSE, NULL, 0);        /* write byte */
+    if (res != 0)                                                                        /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                   /* multiple write byte failed */
         
-        return 1;                                                                                      /* return error */
+        return 1;                                                                        /* return error */
     }
     
-    return 0;                                                                                          /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the ram y address counter
+ * @brief     set the vcom sense duration
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] cnt address counter
+ * @param[in] duration vcom sense duration
  * @return    status code
  *            - 0 success
- *            - 1 set ram y address counter failed
+ *            - 1 set vcom sense duration failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 cnt > 0x1FF
- * @note      none
+ * @note      vcom sense duration = (duration + 1) sec
  */
-uint8_t ssd1681_set_ram_y_address_counter(ssd1681_handle_t *handle, uint16_t cnt)
+uint8_t ssd1681_set_vcom_sense_duration(ssd1681_handle_t *handle, uint8_t duration)
 {
     uint8_t res;
-    uint8_t buf[2];
+    uint8_t buf[1];
     
-    if (handle == NULL)                                                                                /* check handle */
-    {
-        return 2;                                                                                      /* return error */
-    }
-    if (handle->inited != 1)                                                                           /* check handle initialization */
+    if (handle == NULL)                                                                          /* check handle */
     {
-        return 3;                                                                                      /* return error */
+        return 2;                                                                                /* return error */
     }
-    if (cnt > 0x1FF)                                                                                   /* check the result */
+    if (handle->inited != 1)                                                                     /* check handle initialization */
     {
-        handle->debug_print("ssd1681: cnt > 0x1FF.\n");                                                /* cnt > 0x1FF */
-        
-        return 4;                                                                                      /* return error */
+        return 3;                                                                                /* return error */
     }
     
-    buf[0] = cnt & 0xFF;                                                                               /* set the counter low */
-    buf[1] = (cnt >> 8)& 0x01;                                                                         /* set the counter high */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_Y_ADDRESS_COUNTER, buf, 2);        /* write byte */
-    if (res != 0)                                                                                      /* check the result */
+    buf[0] = duration;                                                                           /* set the duration */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_VCOM_SENSE_DURATION, buf, 1);        /* write byte */
+    if (res != 0)                                                                                /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                           /* multiple write byte failed */
         
-        return 1;                                                                                      /* return error */
+        return 1;                                                                                /* return error */
     }
     
-    return 0;                                                                                          /* success return 0 */
+    return 0;                                                                                    /* success return 0 */
 }
 
 /**
- * @brief     nop command
+ * @brief     program vcom otp
  * @param[in] *handle pointer to an ssd1681 handle structure
  * @return    status code
  *            - 0 success
- *            - 1 nop failed
+ *            - 1 otp program vcom failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ssd1681_nop(ssd1681_handle_t *handle)
+uint8_t ssd1681_otp_program_vcom(ssd1681_handle_t *handle)
 {
     uint8_t res;
     
-    if (handle == NULL)                                                           /* check handle */
+    if (handle == NULL)                                                                        /* check handle */
     {
-        return 2;                                                                 /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                      /* check handle initialization */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        return 3;                                                                 /* return error */
+        return 3;                                                                              /* return error */
     }
     
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_NOP, NULL, 0);        /* write byte */
-    if (res != 0)                                                                 /* check the result */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_PROGRAM_VCOM_OTP, NULL, 0);        /* write byte */
+    if (res != 0)                                                                              /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");            /* multiple write byte failed */
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                         /* multiple write byte failed */
         
-        return 1;                                                                 /* return error */
+        return 1;                                                                              /* return error */
     }
     
-    return 0;                                                                     /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief     draw a point in gram
+ * @brief     write register for vcom control
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] color color type
- * @param[in] x coordinate x
- * @param[in] y coordinate y
- * @param[in] data written data
  * @return    status code
  *            - 0 success
- *            - 1 gram draw point failed
+ *            - 1 set vcom control reg failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
  * @note      none
  */
-static uint8_t a_ssd1681_gram_draw_point(ssd1681_handle_t *handle, ssd1681_color_t color, uint8_t x, uint8_t y, uint8_t data)
+uint8_t ssd1681_set_vcom_control_reg(ssd1681_handle_t *handle)
 {
-    uint8_t pos;
-    uint8_t bx;
-    uint8_t temp = 0;
+    uint8_t res;
+    uint8_t buf[2];
     
-    pos = y / 8;                                        /* get y page */
-    bx = y % 8;                                         /* get y point */
-    temp = 1 << (7 - bx);                               /* set data */
-    if (color == SSD1681_COLOR_BLACK)                   /* if black */
+    if (handle == NULL)                                                                                      /* check handle */
     {
-        if (data == 0)                                  /* if 0 */
-        {
-            handle->black_gram[x][pos] |= temp;         /* set 1 */
-        }
-        else
-        {
-            handle->black_gram[x][pos] &= ~temp;        /* set 0 */
-        }
+        return 2;                                                                                            /* return error */
     }
-    else                                                /* if red */
+    if (handle->inited != 1)                                                                                 /* check handle initialization */
     {
-        if (data != 0)                                  /* if 1 */
-        {
-            handle->red_gram[x][pos] |= temp;           /* set 1 */
-        }
-        else
-        {
-            handle->red_gram[x][pos] &= ~temp;          /* set 0 */
-        }
+        return 3;                                                                                            /* return error */
     }
-  
-    return 0;                                           /* success return 0 */
+    
+    buf[0] = 0x04;                                                                                           /* command 1 */
+    buf[1] = 0x63;                                                                                           /* command 2 */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_REGISTER_FOR_VCOM_CONTROL, buf, 2);        /* write byte */
+    if (res != 0)                                                                                            /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                       /* multiple write byte failed */
+        
+        return 1;                                                                                            /* return error */
+    }
+    
+    return 0;                                                                                                /* success return 0 */
 }
 
 /**
- * @brief     draw a char in gram
+ * @brief     write vcom register
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] color color type
- * @param[in] x coordinate x
- * @param[in] y coordinate y
- * @param[in] chr written char
- * @param[in] size char size
- * @param[in] mode display mode
+ * @param[in] vcom set vcom
  * @return    status code
  *            - 0 success
- *            - 1 gram show char failed
+ *            - 1 set vcom register failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
  * @note      none
  */
-static uint8_t a_ssd1681_gram_show_char(ssd1681_handle_t *handle, ssd1681_color_t color, uint8_t x, uint8_t y, uint8_t chr, uint8_t size, uint8_t mode)
+uint8_t ssd1681_set_vcom_register(ssd1681_handle_t *handle, ssd1681_vcom_t vcom)
 {
-    uint8_t temp, t, t1;
-    uint8_t y0 = y;
-    uint8_t csize = (size / 8 + ((size % 8) ? 1 : 0)) * (size / 2);                 /* get size */
+    uint8_t res;
+    uint8_t buf[1];
     
-    chr = chr - ' ';                                                                /* get index */
-    for (t = 0; t < csize; t++)                                                     /* write size */
-    {   
-        if (size == 12)                                                             /* if size 12 */
-        {
-            temp = gsc_ssd1681_ascii_1206[chr][t];                                  /* get ascii 1206 */
-        }
-        else if (size == 16)                                                        /* if size 16 */
-        {
-            temp = gsc_ssd1681_ascii_1608[chr][t];                                  /* get ascii 1608 */
-        }
-        else if(size == 24)                                                         /* if size 24 */
-        {
-            temp = gsc_ssd1681_ascii_2412[chr][t];                                  /* get ascii 2412 */
-        }
-        else
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    buf[0] = vcom;                                                                               /* set the vcom */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_VCOM_REGISTER, buf, 1);        /* write byte */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                           /* multiple write byte failed */
+        
+        return 1;                                                                                /* return error */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      otp register read for display option
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *param pointer to a param buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 otp read register failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ssd1681_otp_read_register(ssd1681_handle_t *handle, uint8_t param[11])
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                                             /* check handle */
+    {
+        return 2;                                                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                                                        /* check handle initialization */
+    {
+        return 3;                                                                                                   /* return error */
+    }
+    
+    res = a_ssd1681_multiple_read_byte(handle, SSD1681_CMD_OTP_REGISTER_READ_FOR_DISPLAY_OPTION, param, 11);        /* read byte */
+    if (res != 0)                                                                                                   /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple read byte failed.\n");                                               /* multiple read byte failed */
+        
+        return 1;                                                                                                   /* return error */
+    }
+    
+    return 0;                                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the user id
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *id pointer to an id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get user id failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ssd1681_get_user_id(ssd1681_handle_t *handle, uint8_t id[10])
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    
+    res = a_ssd1681_multiple_read_byte(handle, SSD1681_CMD_USER_ID_READ, id, 10);        /* read byte */
+    if (res != 0)                                                                        /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple read byte failed.\n");                    /* multiple read byte failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the status
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ssd1681_get_status(ssd1681_handle_t *handle, uint8_t *status)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                        /* check handle */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    
+    res = a_ssd1681_multiple_read_byte(handle, SSD1681_CMD_STATUS_BIT_READ, status, 1);        /* read byte */
+    if (res != 0)                                                                              /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple read byte failed.\n");                          /* multiple read byte failed */
+        
+        return 1;                                                                              /* return error */
+    }
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     program otp of waveform setting
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 otp program waveform failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_otp_program_waveform(ssd1681_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_PROGRAM_WS_OTP, NULL, 0);        /* write byte */
+    if (res != 0)                                                                            /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                       /* multiple write byte failed */
+        
+        return 1;                                                                            /* return error */
+    }
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     load otp of waveform setting
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 otp load waveform failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_otp_load_waveform(ssd1681_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_LOAD_WS_OTP, NULL, 0);        /* write byte */
+    if (res != 0)                                                                         /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                    /* multiple write byte failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     set the lut register
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] *reg pointer to a register buffer
+ * @param[in] len register length
+ * @return    status code
+ *            - 0 success
+ *            - 1 set lut register failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_set_lut_register(ssd1681_handle_t *handle, uint8_t *reg, uint16_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_LUT_REGISTER, reg, len);        /* write byte */
+    if (res != 0)                                                                                 /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                            /* multiple write byte failed */
+        
+        return 1;                                                                                 /* return error */
+    }
+    handle->lut = NULL;                                                                           /* unknown lut */
+    handle->lut_saved = NULL;                                                                     /* not replayed by the resume */
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     set the temperature indexed lut table
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] *table pointer to a lut band table
+ * @param[in] num band number
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 table is invalid
+ * @note      the bands must be sorted by the ascending temperature_min and the table must stay valid,
+ *            no lut is loaded until ssd1681_select_lut or ssd1681_select_lut_by_sensor is called
+ */
+uint8_t ssd1681_set_lut_table(ssd1681_handle_t *handle, const ssd1681_lut_band_t *table, uint8_t num)
+{
+    uint8_t i;
+    
+    if (handle == NULL)                                                                            /* check handle */
+    {
+        return 2;                                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                                       /* check handle initialization */
+    {
+        return 3;                                                                                  /* return error */
+    }
+    if ((table == NULL) || (num == 0))                                                             /* check the table */
+    {
+        handle->debug_print("ssd1681: table is invalid.\n");                                       /* table is invalid */
+        
+        return 4;                                                                                  /* return error */
+    }
+    for (i = 0; i < num; i++)                                                                      /* check all bands */
+    {
+        if ((table[i].lut == NULL) || (table[i].len == 0) ||
+            ((i != 0) && (table[i].temperature_min <= table[i - 1].temperature_min)))              /* check the band */
+        {
+            handle->debug_print("ssd1681: table is invalid.\n");                                   /* table is invalid */
+            
+            return 4;                                                                              /* return error */
+        }
+    }
+    
+    handle->lut_table = table;                                                                     /* save the table */
+    handle->lut_table_num = num;                                                                   /* save the number */
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     load the lut of the temperature band
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] temperature temperature in C
+ * @return    status code
+ *            - 0 success
+ *            - 1 select lut failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 lut table is not set
+ * @note      the band with the highest temperature_min not above the temperature is used,
+ *            a temperature below all bands uses the first band,
+ *            the lut is not written again if it is already loaded,
+ *            the refresh keeps the band instead of loading the otp lut
+ */
+uint8_t ssd1681_select_lut(ssd1681_handle_t *handle, int16_t temperature)
+{
+    uint8_t res;
+    uint8_t i;
+    const ssd1681_lut_band_t *band;
+    
+    if (handle == NULL)                                                                            /* check handle */
+    {
+        return 2;                                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                                       /* check handle initialization */
+    {
+        return 3;                                                                                  /* return error */
+    }
+    if (handle->lut_table == NULL)                                                                 /* check the table */
+    {
+        handle->debug_print("ssd1681: lut table is not set.\n");                                   /* lut table is not set */
+        
+        return 4;                                                                                  /* return error */
+    }
+    
+    band = &handle->lut_table[0];                                                                  /* the coldest band */
+    for (i = 1; i < handle->lut_table_num; i++)                                                    /* find the band */
+    {
+        if (handle->lut_table[i].temperature_min > temperature)                                    /* too cold for the band */
+        {
+            break;                                                                                 /* break */
+        }
+        band = &handle->lut_table[i];                                                              /* warmer band */
+    }
+    res = a_ssd1681_load_lut(handle, band->lut, band->len);                                        /* load the lut */
+    if (res != 0)                                                                                  /* check the result */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      sense the temperature and load the lut of its band
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *temperature pointer to a temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 select lut by sensor failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 lut table is not set
+ * @note       the temperature sensor selected by ssd1681_set_temperature_sensor is used,
+ *             only the temperature is sensed and the loaded band is not replaced by the otp lut
+ */
+uint8_t ssd1681_select_lut_by_sensor(ssd1681_handle_t *handle, int16_t *temperature)
+{
+    uint8_t res;
+    uint8_t buf[2];
+    uint16_t control;
+    
+    if (handle == NULL)                                                                            /* check handle */
+    {
+        return 2;                                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                                       /* check handle initialization */
+    {
+        return 3;                                                                                  /* return error */
+    }
+    if (handle->lut_table == NULL)                                                                 /* check the table */
+    {
+        handle->debug_print("ssd1681: lut table is not set.\n");                                   /* lut table is not set */
+        
+        return 4;                                                                                  /* return error */
+    }
+    
+    res = a_ssd1681_run_sequence(handle, (handle->burst != 0) ? SSD1681_SEQUENCE_LOAD_TEMPERATURE :
+                                 SSD1681_SEQUENCE_SENSE_TEMPERATURE);                              /* sense the temperature */
+    if (res != 0)                                                                                  /* check the result */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    res = a_ssd1681_multiple_read_byte(handle, SSD1681_CMD_TEMPERATURE_SENSOR_CONTROL_READ, buf, 2);   /* read byte */
+    if (res != 0)                                                                                  /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple read byte failed.\n");                              /* multiple read byte failed */
+        
+        return 1;                                                                                  /* return error */
+    }
+    control = (((uint16_t)buf[0]) << 4) | ((buf[1] >> 4) & 0x0F);                                  /* 12 bits, 1/16 C */
+    if ((control & 0x800) != 0)                                                                    /* if negative */
+    {
+        *temperature = (int16_t)(-(int16_t)(((~control) & 0xFFF) + 1) / 16);                       /* convert to C */
+    }
+    else
+    {
+        *temperature = (int16_t)(control / 16);                                                    /* convert to C */
+    }
+    
+    return ssd1681_select_lut(handle, *temperature);                                               /* select the lut */
+}
+
+/**
+ * @brief      get a built-in waveform
+ * @param[in]  waveform waveform type
+ * @param[out] **lut pointer to a lut pointer buffer
+ * @param[out] *len pointer to a lut length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 waveform is invalid
+ * @note       the lut can be used in a ssd1681_lut_band_t table
+ */
+uint8_t ssd1681_get_waveform(ssd1681_waveform_t waveform, const uint8_t **lut, uint16_t *len)
+{
+    if ((lut == NULL) || (len == NULL))                                 /* check the buffer */
+    {
+        return 2;                                                       /* return error */
+    }
+    
+    switch (waveform)                                                   /* choose the waveform */
+    {
+        case SSD1681_WAVEFORM_FULL :
+        {
+            *lut = gsc_ssd1681_waveform_full;                           /* full quality */
+            *len = sizeof(gsc_ssd1681_waveform_full);                   /* set the length */
+            
+            break;
+        }
+        case SSD1681_WAVEFORM_FAST :
+        {
+            *lut = gsc_ssd1681_waveform_fast;                           /* fast full */
+            *len = sizeof(gsc_ssd1681_waveform_fast);                   /* set the length */
+            
+            break;
+        }
+        case SSD1681_WAVEFORM_PARTIAL :
+        {
+            *lut = gsc_ssd1681_waveform_partial;                        /* partial */
+            *len = sizeof(gsc_ssd1681_waveform_partial);                /* set the length */
+            
+            break;
+        }
+        default :
+        {
+            return 4;                                                   /* return error */
+        }
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     load a built-in waveform
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] waveform waveform type
+ * @return    status code
+ *            - 0 success
+ *            - 1 use waveform failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 waveform is invalid
+ * @note      the lut is not written again if it is already loaded,
+ *            it is kept by the refresh and written again by ssd1681_resume
+ */
+uint8_t ssd1681_use_waveform(ssd1681_handle_t *handle, ssd1681_waveform_t waveform)
+{
+    const uint8_t *lut;
+    uint16_t len;
+    
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (handle->inited != 1)                                            /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    if (ssd1681_get_waveform(waveform, &lut, &len) != 0)                /* get the waveform */
+    {
+        handle->debug_print("ssd1681: waveform is invalid.\n");         /* waveform is invalid */
+        
+        return 4;                                                       /* return error */
+    }
+    if (a_ssd1681_load_lut(handle, lut, len) != 0)                      /* load the lut */
+    {
+        return 1;                                                       /* return error */
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     set the crc calculation
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set crc calculation failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the crc covers the otp content, not the display ram
+ */
+uint8_t ssd1681_set_crc_calculation(ssd1681_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_CRC_CALCULATION, NULL, 0);        /* write byte */
+    if (res != 0)                                                                             /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                        /* multiple write byte failed */
+        
+        return 1;                                                                             /* return error */
+    }
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      get the crc status
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get crc status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the crc covers the otp content, not the display ram
+ */
+uint8_t ssd1681_get_crc_status(ssd1681_handle_t *handle, uint16_t *status)
+{
+    uint8_t res;
+    uint8_t buf[2];
+    
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    
+    res = a_ssd1681_multiple_read_byte(handle, SSD1681_CMD_CRC_STATUS_READ, buf, 2);        /* read byte */
+    if (res != 0)                                                                           /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple read byte failed.\n");                       /* multiple read byte failed */
+        
+        return 1;                                                                           /* return error */
+    }
+    *status = (uint16_t)(buf[0] << 0) | buf[1];                                             /* set the status */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     program otp selection
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 otp program selection failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_otp_program_selection(ssd1681_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                             /* check handle */
+    {
+        return 2;                                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                                        /* check handle initialization */
+    {
+        return 3;                                                                                   /* return error */
+    }
+    
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_PROGRAM_OTP_SELECTION, NULL, 0);        /* write byte */
+    if (res != 0)                                                                                   /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                              /* multiple write byte failed */
+        
+        return 1;                                                                                   /* return error */
+    }
+    
+    return 0;                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     otp write register for display option
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] *param pointer to a param buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 otp write register failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_otp_write_register(ssd1681_handle_t *handle, uint8_t param[11])
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                                           /* check handle */
+    {
+        return 2;                                                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                                 /* return error */
+    }
+    
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_REGISTER_FOR_DISPLAY_OPTION, param, 11);        /* write byte */
+    if (res != 0)                                                                                                 /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                            /* multiple write byte failed */
+        
+        return 1;                                                                                                 /* return error */
+    }
+    
+    return 0;                                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     set the user id
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] *id pointer to an id buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 set user id failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_set_user_id(ssd1681_handle_t *handle, uint8_t id[10])
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                                 /* check handle */
+    {
+        return 2;                                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                                            /* check handle initialization */
+    {
+        return 3;                                                                                       /* return error */
+    }
+    
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_REGISTER_FOR_USER_ID, id, 10);        /* write byte */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                  /* multiple write byte failed */
+        
+        return 1;                                                                                       /* return error */
+    }
+    
+    return 0;                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     set the otp program mode
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] mode otp mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 otp program mode failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_otp_program_mode(ssd1681_handle_t *handle, ssd1681_otp_mode_t mode)
+{
+    uint8_t res;
+    uint8_t buf[1];
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    
+    buf[0] = mode;                                                                            /* set the mode */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_OTP_PROGRAM_MODE, buf, 1);        /* write byte */
+    if (res != 0)                                                                             /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                        /* multiple write byte failed */
+        
+        return 1;                                                                             /* return error */
+    }
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     set the border waveform
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] vbd select vbd option
+ * @param[in] level fix level setting for vbd
+ * @param[in] gs_tran gs transition control
+ * @param[in] vbd_tran gs transition setting for vbd
+ * @return    status code
+ *            - 0 success
+ *            - 1 set border waveform failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_set_border_waveform(ssd1681_handle_t *handle, ssd1681_vbd_t vbd, ssd1681_vbd_fix_level_t level,
+                                    ssd1681_gs_transition_t gs_tran, ssd1681_vbd_transition_t vbd_tran)
+{
+    uint8_t res;
+    uint8_t buf[1];
+    
+    if (handle == NULL)                                                                              /* check handle */
+    {
+        return 2;                                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                                         /* check handle initialization */
+    {
+        return 3;                                                                                    /* return error */
+    }
+    
+    buf[0] = (uint8_t)((vbd << 6) | (level << 4) | (gs_tran << 2) | (vbd_tran << 0));                /* set the mode */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_BORDER_WAVEFORM_CONTROL, buf, 1);        /* write byte */
+    if (res != 0)                                                                                    /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                               /* multiple write byte failed */
+        
+        return 1;                                                                                    /* return error */
+    }
+    
+    return 0;                                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     end option
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] opt end option
+ * @return    status code
+ *            - 0 success
+ *            - 1 set end option failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_set_end_option(ssd1681_handle_t *handle, ssd1681_end_opt_t opt)
+{
+    uint8_t res;
+    uint8_t buf[1];
+    
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    
+    buf[0] = opt;                                                                       /* set the mode */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_END_OPTION, buf, 1);        /* write byte */
+    if (res != 0)                                                                       /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                  /* multiple write byte failed */
+        
+        return 1;                                                                       /* return error */
+    }
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     set the read ram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] ram read ram option
+ * @return    status code
+ *            - 0 success
+ *            - 1 set read ram failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_set_read_ram(ssd1681_handle_t *handle, ssd1681_read_ram_t ram)
+{
+    uint8_t res;
+    uint8_t buf[1];
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    
+    buf[0] = ram;                                                                            /* set the mode */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_READ_RAM_OPTION, buf, 1);        /* write byte */
+    if (res != 0)                                                                            /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                       /* multiple write byte failed */
+        
+        return 1;                                                                            /* return error */
+    }
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     set the ram x range
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] start start address
+ * @param[in] end end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 set ram x failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 start > 0x3F
+ *            - 5 end > 0x3F
+ * @note      none
+ */
+uint8_t ssd1681_set_ram_x(ssd1681_handle_t *handle, uint8_t start, uint8_t end)
+{
+    uint8_t res;
+    uint8_t buf[2];
+    
+    if (handle == NULL)                                                                /* check handle */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                           /* check handle initialization */
+    {
+        return 3;                                                                      /* return error */
+    }
+    if (start > 0x3F)                                                                  /* check the start */
+    {
+        handle->debug_print("ssd1681: start > 0x3F.\n");                               /* start > 0x3F */
+        
+        return 4;                                                                      /* return error */
+    }
+    if (end > 0x3F)                                                                    /* check the end */
+    {
+        handle->debug_print("ssd1681: end > 0x3F.\n");                                 /* end > 0x3F */
+        
+        return 5;                                                                      /* return error */
+    }
+    
+    buf[0] = start;                                                                    /* set the start address */
+    buf[1] = end;                                                                      /* set the end address */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_X, buf, 2);        /* write byte */
+    if (res != 0)                                                                      /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                 /* multiple write byte failed */
+        
+        return 1;                                                                      /* return error */
+    }
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     set the ram y range
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] start start address
+ * @param[in] end end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 set ram y failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_set_ram_y(ssd1681_handle_t *handle, uint16_t start, uint16_t end)
+{
+    uint8_t res;
+    uint8_t buf[4];
+    
+    if (handle == NULL)                                                                /* check handle */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                           /* check handle initialization */
+    {
+        return 3;                                                                      /* return error */
+    }
+    
+    buf[0] = start & 0xFF;                                                             /* set the start address */
+    buf[1] = (start >> 8) & 0x1;                                                       /* set the start address */
+    buf[2] = end & 0xFF;                                                               /* set the end address */
+    buf[3] = (end >> 8) & 0x01;                                                        /* set the end address */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_Y, buf, 4);        /* write byte */
+    if (res != 0)                                                                      /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                 /* multiple write byte failed */
+        
+        return 1;                                                                      /* return error */
+    }
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     set the auto write red ram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] height step height
+ * @param[in] width step width
+ * @return    status code
+ *            - 0 success
+ *            - 1 set auto write red ram failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_set_auto_write_red_ram(ssd1681_handle_t *handle, ssd1681_step_height_t height, ssd1681_step_width_t width)
+{
+    uint8_t res;
+    uint8_t buf[1];
+    
+    if (handle == NULL)                                                                                             /* check handle */
+    {
+        return 2;                                                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                                                        /* check handle initialization */
+    {
+        return 3;                                                                                                   /* return error */
+    }
+    
+    buf[0] = (uint8_t)((height << 4) | (width << 0));                                                               /* set the param */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_AUTO_WRITE_RED_RAM_FOR_REGULAR_PATTERN, buf, 1);        /* write byte */
+    if (res != 0)                                                                                                   /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                              /* multiple write byte failed */
+        
+        return 1;                                                                                                   /* return error */
+    }
+    
+    return 0;                                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     set the auto write black ram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] height step height
+ * @param[in] width step width
+ * @return    status code
+ *            - 0 success
+ *            - 1 set auto write black ram failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_set_auto_write_black_ram(ssd1681_handle_t *handle, ssd1681_step_height_t height, ssd1681_step_width_t width)
+{
+    uint8_t res;
+    uint8_t buf[1];
+    
+    if (handle == NULL)                                                                                            /* check handle */
+    {
+        return 2;                                                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                                                       /* check handle initialization */
+    {
+        return 3;                                                                                                  /* return error */
+    }
+    
+    buf[0] = (uint8_t)((height << 4) | (width << 0));                                                              /* set the param */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_AUTO_WRITE_BW_RAM_FOR_REGULAR_PATTERN, buf, 1);        /* write byte */
+    if (res != 0)                                                                                                  /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                             /* multiple write byte failed */
+        
+        return 1;                                                                                                  /* return error */
+    }
+    
+    return 0;                                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     set the ram x address counter
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] cnt address counter
+ * @return    status code
+ *            - 0 success
+ *            - 1 set ram x address counter failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 cnt > 0x3F
+ * @note      none
+ */
+uint8_t ssd1681_set_ram_x_address_counter(ssd1681_handle_t *handle, uint8_t cnt)
+{
+    uint8_t res;
+    uint8_t buf[1];
+    
+    if (handle == NULL)                                                                                /* check handle */
+    {
+        return 2;                                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                                           /* check handle initialization */
+    {
+        return 3;                                                                                      /* return error */
+    }
+    if (cnt > 0x3F)                                                                                    /* check the result */
+    {
+        handle->debug_print("ssd1681: cnt > 0x3F.\n");                                                 /* cnt > 0x3F */
+        
+        return 4;                                                                                      /* return error */
+    }
+    
+    buf[0] = cnt;                                                                                      /* set the counter */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_X_ADDRESS_COUNTER, buf, 1);        /* write byte */
+    if (res != 0)                                                                                      /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        
+        return 1;                                                                                      /* return error */
+    }
+    
+    return 0;                                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     set the ram y address counter
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] cnt address counter
+ * @return    status code
+ *            - 0 success
+ *            - 1 set ram y address counter failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 cnt > 0x1FF
+ * @note      none
+ */
+uint8_t ssd1681_set_ram_y_address_counter(ssd1681_handle_t *handle, uint16_t cnt)
+{
+    uint8_t res;
+    uint8_t buf[2];
+    
+    if (handle == NULL)                                                                                /* check handle */
+    {
+        return 2;                                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                                           /* check handle initialization */
+    {
+        return 3;                                                                                      /* return error */
+    }
+    if (cnt > 0x1FF)                                                                                   /* check the result */
+    {
+        handle->debug_print("ssd1681: cnt > 0x1FF.\n");                                                /* cnt > 0x1FF */
+        
+        return 4;                                                                                      /* return error */
+    }
+    
+    buf[0] = cnt & 0xFF;                                                                               /* set the counter low */
+    buf[1] = (cnt >> 8)& 0x01;                                                                         /* set the counter high */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_Y_ADDRESS_COUNTER, buf, 2);        /* write byte */
+    if (res != 0)                                                                                      /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        
+        return 1;                                                                                      /* return error */
+    }
+    
+    return 0;                                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     nop command
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 nop failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_nop(ssd1681_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                           /* check handle */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                      /* check handle initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_NOP, NULL, 0);        /* write byte */
+    if (res != 0)                                                                 /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");            /* multiple write byte failed */
+        
+        return 1;                                                                 /* return error */
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     draw a point in gram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @param[in] x coordinate x
+ * @param[in] y coordinate y
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram draw point failed
+ * @note      none
+ */
+static uint8_t a_ssd1681_gram_draw_point(ssd1681_handle_t *handle, ssd1681_color_t color, uint8_t x, uint8_t y, uint8_t data)
+{
+    uint8_t pos;
+    uint8_t bx;
+    uint8_t temp = 0;
+    
+    pos = y / 8;                                        /* get y page */
+    bx = y % 8;                                         /* get y point */
+    temp = 1 << (7 - bx);                               /* set data */
+    if (color == SSD1681_COLOR_BLACK)                   /* if black */
+    {
+        if (data == 0)                                  /* if 0 */
+        {
+            handle->black_gram[x][pos] |= temp;         /* set 1 */
+        }
+        else
+        {
+            handle->black_gram[x][pos] &= ~temp;        /* set 0 */
+        }
+    }
+#if (SSD1681_MONOCHROME == 0)
+    else                                                /* if red */
+    {
+        if (data != 0)                                  /* if 1 */
+        {
+            handle->red_gram[x][pos] |= temp;           /* set 1 */
+        }
+        else
+        {
+            handle->red_gram[x][pos] &= ~temp;          /* set 0 */
+        }
+    }
+#endif
+  
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief     draw a char in gram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @param[in] x coordinate x
+ * @param[in] y coordinate y
+ * @param[in] chr written char
+ * @param[in] size char size
+ * @param[in] mode display mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram show char failed
+ * @note      none
+ */
+static uint8_t a_ssd1681_gram_show_char(ssd1681_handle_t *handle, ssd1681_color_t color, uint8_t x, uint8_t y, uint8_t chr, uint8_t size, uint8_t mode)
+{
+    uint8_t temp, t, t1;
+    uint8_t y0 = y;
+    uint8_t csize = (size / 8 + ((size % 8) ? 1 : 0)) * (size / 2);                 /* get size */
+    
+    chr = chr - ' ';                                                                /* get index */
+    for (t = 0; t < csize; t++)                                                     /* write size */
+    {   
+        if (size == 12)                                                             /* if size 12 */
+        {
+            temp = gsc_ssd1681_ascii_1206[chr][t];                                  /* get ascii 1206 */
+        }
+        else if (size == 16)                                                        /* if size 16 */
+        {
+            temp = gsc_ssd1681_ascii_1608[chr][t];                                  /* get ascii 1608 */
+        }
+        else if(size == 24)                                                         /* if size 24 */
+        {
+            temp = gsc_ssd1681_ascii_2412[chr][t];                                  /* get ascii 2412 */
+        }
+        else
+        {
+            return 1;                                                               /* return error */
+        }
+        for (t1 = 0; t1 < 8; t1++)                                                  /* write one line */
+        {
+            if ((temp & 0x80) != 0)                                                 /* if 1 */
+            {
+                if (a_ssd1681_gram_draw_point(handle, color, x, y, mode) != 0)      /* draw point */
+                {
+                    return 1;                                                       /* return error */
+                }
+            }
+            else 
+            {
+                if (a_ssd1681_gram_draw_point(handle, color, x, y, !mode) != 0)     /* draw point */
+                {
+                    return 1;                                                       /* return error */
+                }
+            }
+            temp <<= 1;                                                             /* left shift 1 */
+            y++;
+            if ((y - y0) == size)                                                   /* reset size */
+            {
+                y = y0;                                                             /* set y */
+                x++;                                                                /* x++ */
+                
+                break;                                                              /* break */
+            }
+        }
+    }
+  
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     update the ram clear flag from the gram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @note      call it only when the gram matches the controller ram
+ */
+static void a_ssd1681_ram_clear_update(ssd1681_handle_t *handle, ssd1681_color_t color)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t value;
+    
+    for (i = 0; i < 200; i++)                                                     /* x */
+    {
+        for (j = 0; j < 25; j++)                                                  /* y */
+        {
+            if (color == SSD1681_COLOR_BLACK)                                     /* if black */
+            {
+                value = (uint8_t)(handle->black_gram[i][j] ^ 0xFF);               /* clear is 0xFF */
+            }
+            else                                                                  /* if red */
+            {
+                value = SSD1681_GRAM(handle, color)[i][j];                        /* clear is 0x00 */
+            }
+            if (value != 0)                                                       /* not clear */
+            {
+                handle->ram_clear &= (uint8_t)(~(1 << color));                    /* drop the clear flag */
+                
+                return;                                                           /* return */
+            }
+        }
+    }
+    handle->ram_clear |= (uint8_t)(1 << color);                                   /* flag the ram clear */
+}
+
+/**
+ * @brief      get the current ram window
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *window pointer to a 6 bytes buffer
+ * @note       the full panel window is used when the shadow does not know it
+ */
+static void a_ssd1681_window_get(ssd1681_handle_t *handle, uint8_t *window)
+{
+    uint8_t i;
+    
+    memcpy(window, gsc_ssd1681_full_window, 6);                                                         /* default full window */
+    i = a_ssd1681_shadow_find(SSD1681_CMD_SET_RAM_X);                                                   /* find the ram x */
+    if ((handle->shadow_valid & (1U << i)) != 0)                                                        /* if known */
+    {
+        memcpy(&window[0], &handle->shadow[gsc_ssd1681_shadow[i].offset], 2);                           /* save the ram x */
+    }
+    i = a_ssd1681_shadow_find(SSD1681_CMD_SET_RAM_Y);                                                   /* find the ram y */
+    if ((handle->shadow_valid & (1U << i)) != 0)                                                        /* if known */
+    {
+        memcpy(&window[2], &handle->shadow[gsc_ssd1681_shadow[i].offset], 4);                           /* save the ram y */
+    }
+}
+
+/**
+ * @brief     set the ram window and move the address counters to its start
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] x_start start x byte address
+ * @param[in] x_end end x byte address
+ * @param[in] y_start start y address
+ * @param[in] y_end end y address
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      none
+ */
+static uint8_t a_ssd1681_window_set(ssd1681_handle_t *handle, uint8_t x_start, uint8_t x_end, uint16_t y_start, uint16_t y_end)
+{
+    uint8_t res;
+    uint8_t data[4];
+    
+    data[0] = x_start;                                                                                  /* set the x start */
+    data[1] = x_end;                                                                                    /* set the x end */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_X, data, 2);                        /* write byte */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                  /* multiple write byte failed */
+        
+        return 1;                                                                                       /* return error */
+    }
+    data[0] = y_start & 0xFF;                                                                           /* set the y start */
+    data[1] = (y_start >> 8) & 0x01;                                                                    /* set the y start */
+    data[2] = y_end & 0xFF;                                                                             /* set the y end */
+    data[3] = (y_end >> 8) & 0x01;                                                                      /* set the y end */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_Y, data, 4);                        /* write byte */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                  /* multiple write byte failed */
+        
+        return 1;                                                                                       /* return error */
+    }
+    data[0] = x_start;                                                                                  /* set the x counter */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_X_ADDRESS_COUNTER, data, 1);        /* write byte */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                  /* multiple write byte failed */
+        
+        return 1;                                                                                       /* return error */
+    }
+    data[0] = y_start & 0xFF;                                                                           /* set the y counter */
+    data[1] = (y_start >> 8) & 0x01;                                                                    /* set the y counter */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_Y_ADDRESS_COUNTER, data, 2);        /* write byte */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                  /* multiple write byte failed */
+        
+        return 1;                                                                                       /* return error */
+    }
+    
+    return 0;                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     set the ram window back
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] *window pointer to the previous ram window
+ * @return    status code
+ *            - 0 success
+ *            - 1 restore failed
+ * @note      the address counters are left where they are
+ */
+static uint8_t a_ssd1681_window_restore(ssd1681_handle_t *handle, uint8_t *window)
+{
+    uint8_t res;
+    
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_X, &window[0], 2);                  /* restore the ram x */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                  /* multiple write byte failed */
+        
+        return 1;                                                                                       /* return error */
+    }
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_Y, &window[2], 4);                  /* restore the ram y */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                  /* multiple write byte failed */
+        
+        return 1;                                                                                       /* return error */
+    }
+    
+    return 0;                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     hash the gram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @return    gram hash
+ * @note      the gram is hashed a 32-bit word at a time, every step is invertible,
+ *            so a change in a single word always changes the hash
+ */
+static uint32_t a_ssd1681_gram_hash(ssd1681_handle_t *handle, ssd1681_color_t color)
+{
+    const uint8_t *gram;
+    uint32_t word;
+    uint32_t hash;
+    uint16_t i;
+    
+    gram = &SSD1681_GRAM(handle, color)[0][0];                                                      /* get the gram */
+    hash = 0x811C9DC5U;                                                                             /* fnv offset basis */
+    for (i = 0; i < 200 * 25; i += 4)                                                               /* all words */
+    {
+        memcpy(&word, gram + i, 4);                                                                 /* get the word */
+        hash = (hash ^ word) * 0x01000193U;                                                         /* fnv prime */
+    }
+    
+    return hash;                                                                                    /* return the hash */
+}
+
+/**
+ * @brief     flag the controller ram in sync with the gram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @note      call it only when the gram matches the controller ram
+ */
+static void a_ssd1681_ram_sync(ssd1681_handle_t *handle, ssd1681_color_t color)
+{
+    a_ssd1681_ram_clear_update(handle, color);                                    /* update the clear flag */
+    handle->ram_hash[color] = a_ssd1681_gram_hash(handle, color);                 /* save the ram hash */
+    handle->ram_hash_valid |= (uint8_t)(1 << color);                              /* flag the ram hash */
+    if (handle->diff_gram[color] != NULL)                                         /* if the last frame is kept */
+    {
+        memcpy(handle->diff_gram[color], &SSD1681_GRAM(handle, color)[0][0], 200 * 25);    /* save the last frame */
+        handle->diff_valid |= (uint8_t)(1 << color);                              /* flag the last frame */
+    }
+}
+
+/**
+ * @brief     check if the gram matches the controller ram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @return    status code
+ *            - 0 the gram is changed or the update is forced
+ *            - 1 the gram matches the controller ram
+ * @note      none
+ */
+static uint8_t a_ssd1681_gram_unchanged(ssd1681_handle_t *handle, ssd1681_color_t color)
+{
+    if ((handle->force != 0) || ((handle->ram_hash_valid & (1 << color)) == 0))         /* forced or unknown */
+    {
+        return 0;                                                                       /* changed */
+    }
+    
+    return (a_ssd1681_gram_hash(handle, color) == handle->ram_hash[color]) ? 1 : 0;     /* compare the hash */
+}
+
+/**
+ * @brief     check if the ram layout is the one used by the gram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    status code
+ *            - 0 unknown or other layout
+ *            - 1 full panel window with the y decrement x increment data entry mode
+ * @note      gram row i is ram y 199 - i and gram byte j is ram x byte j in this layout
+ */
+static uint8_t a_ssd1681_ram_layout_check(ssd1681_handle_t *handle)
+{
+    uint8_t i;
+    uint8_t window[6];
+    
+    a_ssd1681_window_get(handle, window);                                                              /* get the ram window */
+    i = a_ssd1681_shadow_find(SSD1681_CMD_DATA_ENTRY_MODE_SETTING);                                    /* find the data entry mode */
+    if ((memcmp(window, gsc_ssd1681_full_window, 6) != 0) || ((handle->shadow_valid & (1U << i)) == 0) ||
+        (handle->shadow[gsc_ssd1681_shadow[i].offset] != 0x01))                                        /* check the layout */
+    {
+        return 0;                                                                                      /* other layout */
+    }
+    
+    return 1;                                                                                          /* default layout */
+}
+
+/**
+ * @brief     upload only the changed rows of the gram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @return    status code
+ *            - 0 success
+ *            - 1 upload failed
+ *            - 2 the full upload is needed
+ * @note      every run of changed rows is sent in its own window that spans the changed bytes,
+ *            it needs the full panel window and the y decrement x increment data entry mode
+ */
+static uint8_t a_ssd1681_gram_upload_diff(ssd1681_handle_t *handle, ssd1681_color_t color)
+{
+    uint8_t res;
+    uint8_t left;
+    uint8_t right;
+    uint8_t l;
+    uint8_t r;
+    uint16_t row;
+    uint16_t start;
+    const uint8_t *gram;
+    const uint8_t *last;
+    
+    if (a_ssd1681_ram_layout_check(handle) == 0)                                                       /* check the layout */
+    {
+        return 2;                                                                                      /* full upload */
+    }
+    gram = &SSD1681_GRAM(handle, color)[0][0];                                                         /* get the gram */
+    last = handle->diff_gram[color];                                                                   /* get the last frame */
+    
+    row = 0;                                                                                           /* init 0 */
+    while (row < 200)                                                                                  /* check all rows */
+    {
+        if (memcmp(gram + row * 25, last + row * 25, 25) == 0)                                         /* unchanged row */
+        {
+            row++;                                                                                     /* next row */
+            
+            continue;                                                                                  /* continue */
+        }
+        start = row;                                                                                   /* run start */
+        left = 24;                                                                                     /* init 24 */
+        right = 0;                                                                                     /* init 0 */
+        while ((row < 200) && (memcmp(gram + row * 25, last + row * 25, 25) != 0))                     /* changed rows */
+        {
+            for (l = 0; gram[row * 25 + l] == last[row * 25 + l]; l++)                                 /* first changed byte */
+            {
+                ;
+            }
+            for (r = 24; gram[row * 25 + r] == last[row * 25 + r]; r--)                                /* last changed byte */
+            {
+                ;
+            }
+            left = (l < left) ? l : left;                                                              /* widen the window */
+            right = (r > right) ? r : right;                                                           /* widen the window */
+            row++;                                                                                     /* next row */
+        }
+        res = a_ssd1681_window_set(handle, left, right, 0xC7 - start, 0xC7 - (row - 1));               /* set the run window */
+        if (res != 0)                                                                                  /* check the result */
+        {
+            return 1;                                                                                  /* return error */
+        }
+        res = a_ssd1681_multiple_write_byte(handle, (color == SSD1681_COLOR_BLACK) ?
+                                            SSD1681_CMD_WRITE_RAM_BLACK : SSD1681_CMD_WRITE_RAM_RED,
+                                            NULL, 0);                                                  /* write byte */
+        if (res != 0)                                                                                  /* check the result */
+        {
+            handle->debug_print("ssd1681: multiple write byte failed.\n");                             /* multiple write byte failed */
+            
+            return 1;                                                                                  /* return error */
+        }
+        for (; start < row; start++)                                                                   /* send the run */
+        {
+            res = a_ssd1681_spi_write(handle, SSD1681_DATA, (uint8_t *)gram + start * 25 + left,
+                                      (uint16_t)(right - left + 1));                                   /* write the changed bytes */
+            if (res != 0)                                                                              /* check error */
+            {
+                handle->debug_print("ssd1681: spi write cmd failed.\n");                               /* spi write cmd failed */
+                
+                return 1;                                                                              /* return error */
+            }
+        }
+    }
+    res = a_ssd1681_window_restore(handle, (uint8_t *)gsc_ssd1681_full_window);                        /* restore the ram window */
+    if (res != 0)                                                                                      /* check the result */
+    {
+        return 1;                                                                                      /* return error */
+    }
+    
+    return 0;                                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     upload the gram to the controller ram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @return    status code
+ *            - 0 success
+ *            - 1 upload failed
+ * @note      none
+ */
+static uint8_t a_ssd1681_gram_upload(ssd1681_handle_t *handle, ssd1681_color_t color)
+{
+    uint8_t res;
+    uint8_t buf[2];
+    
+    if (a_ssd1681_power_wake(handle) != 0)                                                             /* wake the chip */
+    {
+        return 1;                                                                                      /* return error */
+    }
+    if ((handle->force == 0) && ((handle->diff_valid & (1 << color)) != 0))                            /* the last frame is known */
+    {
+        res = a_ssd1681_gram_upload_diff(handle, color);                                               /* upload the changes */
+        if (res == 1)                                                                                  /* check the result */
+        {
+            return 1;                                                                                  /* return error */
+        }
+        if (res == 0)                                                                                  /* uploaded */
+        {
+            handle->staged |= (uint8_t)(1 << color);                                                   /* flag the plane staged */
+            a_ssd1681_ram_sync(handle, color);                                                         /* the ram holds the gram */
+            
+            return 0;                                                                                  /* success return 0 */
+        }
+    }
+    buf[0] = 0x00;                                                                                     /* set 0x00 */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_X_ADDRESS_COUNTER, buf, 1);        /* write byte */
+    if (res != 0)                                                                                      /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        
+        return 1;                                                                                      /* return error */
+    }
+    buf[0] = 0xC7;                                                                                     /* set 0xC7 */
+    buf[1] = 0x00;                                                                                     /* set 0x00 */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_Y_ADDRESS_COUNTER, buf, 2);        /* write byte */
+    if (res != 0)                                                                                      /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        
+        return 1;                                                                                      /* return error */
+    }
+    if (color == SSD1681_COLOR_BLACK)                                                                  /* if black */
+    {
+        res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_RAM_BLACK, NULL, 0);             /* write byte */
+        if (res != 0)                                                                                  /* check the result */
+        {
+            handle->debug_print("ssd1681: multiple write byte failed.\n");                             /* multiple write byte failed */
+            
+            return 1;                                                                                  /* return error */
+        }
+        res = a_ssd1681_spi_write(handle, SSD1681_DATA, &handle->black_gram[0][0], 200 * 25);          /* write gram */
+        if (res != 0)                                                                                  /* check error */
         {
-            return 1;                                                               /* return error */
+            handle->debug_print("ssd1681: spi write cmd failed.\n");                                   /* spi write cmd failed */
+            
+            return 1;                                                                                  /* return error */
         }
-        for (t1 = 0; t1 < 8; t1++)                                                  /* write one line */
+    }
+    else                                                                                               /* if red */
+    {
+        res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_RAM_RED, NULL, 0);               /* write byte */
+        if (res != 0)                                                                                  /* check the result */
+        {
+            handle->debug_print("ssd1681: multiple write byte failed.\n");                             /* multiple write byte failed */
+            
+            return 1;                                                                                  /* return error */
+        }
+        res = a_ssd1681_spi_write(handle, SSD1681_DATA, &SSD1681_GRAM(handle, color)[0][0], 200 * 25); /* write gram */
+        if (res != 0)                                                                                  /* check error */
+        {
+            handle->debug_print("ssd1681: spi write cmd failed.\n");                                   /* spi write cmd failed */
+            
+            return 1;                                                                                  /* return error */
+        }
+    }
+    handle->staged |= (uint8_t)(1 << color);                                                           /* flag the plane staged */
+    a_ssd1681_ram_sync(handle, color);                                                                 /* the ram holds the gram */
+    
+    return 0;                                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     fill the controller ram with a regular pattern on the chip
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @param[in] height step height
+ * @param[in] width step width
+ * @param[in] first first step value
+ * @return    status code
+ *            - 0 success
+ *            - 1 fill failed
+ *            - 2 the ram layout is not the default one
+ * @note      the steps form a checkerboard starting at ram x 0 and y 0,
+ *            200 as both sizes fills the whole ram with the first value,
+ *            the gram is set to the same pattern, in the monochrome build only the red ram is filled for red
+ */
+static uint8_t a_ssd1681_gram_fill(ssd1681_handle_t *handle, ssd1681_color_t color,
+                                   ssd1681_step_height_t height, ssd1681_step_width_t width, uint8_t first)
+{
+    uint8_t res;
+    uint8_t buf[1];
+    uint8_t value;
+    uint8_t mask;
+    uint8_t j;
+    uint16_t i;
+    uint8_t *gram;
+    
+#if (SSD1681_MONOCHROME != 0)
+    if ((color == SSD1681_COLOR_BLACK) && (a_ssd1681_ram_layout_check(handle) == 0))                   /* check the layout */
+#else
+    if (a_ssd1681_ram_layout_check(handle) == 0)                                                       /* check the layout */
+#endif
+    {
+        return 2;                                                                                      /* not supported */
+    }
+    if (a_ssd1681_power_wake(handle) != 0)                                                             /* wake the chip */
+    {
+        return 1;                                                                                      /* return error */
+    }
+    buf[0] = (uint8_t)(((first & 0x01) << 7) | (height << 4) | (width << 0));                          /* set the param */
+    res = a_ssd1681_multiple_write_byte(handle, (color == SSD1681_COLOR_BLACK) ?
+                                        SSD1681_CMD_AUTO_WRITE_BW_RAM_FOR_REGULAR_PATTERN :
+                                        SSD1681_CMD_AUTO_WRITE_RED_RAM_FOR_REGULAR_PATTERN,
+                                        buf, 1);                                                       /* write byte */
+    if (res != 0)                                                                                      /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        
+        return 1;                                                                                      /* return error */
+    }
+#if (SSD1681_MONOCHROME != 0)
+    if (color != SSD1681_COLOR_BLACK)                                                                  /* no red gram */
+    {
+        handle->staged |= (uint8_t)(1 << color);                                                       /* flag the plane staged */
+        handle->ram_hash_valid &= (uint8_t)(~(1 << color));                                            /* drop the ram hash */
+        handle->diff_valid &= (uint8_t)(~(1 << color));                                                /* drop the last frame */
+        
+        return 0;                                                                                      /* success return 0 */
+    }
+#endif
+    
+    gram = &SSD1681_GRAM(handle, color)[0][0];                                                         /* get the gram */
+    for (i = 0; i < 200; i++)                                                                          /* all rows */
+    {
+        value = (uint8_t)((((199 - i) / gsc_ssd1681_step[height]) ^ first) & 0x01) ? 0xFF : 0x00;      /* row value */
+        if (width == SSD1681_STEP_WIDTH_200)                                                           /* no step in the row */
+        {
+            memset(gram + i * 25, value, 25);                                                          /* set the row */
+        }
+        else
+        {
+            for (j = 0; j < 25; j++)                                                                   /* all bytes */
+            {
+                mask = (uint8_t)((((j * 8) / gsc_ssd1681_step[width]) & 0x01) ? 0xFF : 0x00);          /* column value */
+                gram[i * 25 + j] = (uint8_t)(value ^ mask);                                            /* set the byte */
+            }
+        }
+    }
+    handle->staged |= (uint8_t)(1 << color);                                                           /* flag the plane staged */
+    a_ssd1681_ram_sync(handle, color);                                                                 /* the ram holds the gram */
+    
+    return 0;                                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     activate the display update with the controller ram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 activate failed
+ * @note      in the burst mode only the display step of the sequence is run
+ */
+static uint8_t a_ssd1681_gram_activate(ssd1681_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t sequence;
+    
+    if (a_ssd1681_power_wake(handle) != 0)                                                             /* wake the chip */
+    {
+        return 1;                                                                                      /* return error */
+    }
+    if (handle->burst != 0)                                                                            /* if burst */
+    {
+        sequence = SSD1681_SEQUENCE_BURST_DISPLAY;                                                     /* display only */
+    }
+    else
+    {
+        sequence = SSD1681_SEQUENCE_FULL;                                                              /* full sequence */
+    }
+    res = a_ssd1681_run_sequence(handle, sequence);                                                    /* run the sequence */
+    if (res != 0)                                                                                      /* check the result */
+    {
+        return 1;                                                                                      /* return error */
+    }
+    handle->staged = 0;                                                                                /* clear the staged planes */
+    
+    return 0;                                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     clear the screen
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @return    status code
+ *            - 0 success
+ *            - 1 clear failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the upload is skipped when the controller ram is known to be clear and the force update is disabled,
+ *            so is the refresh if nothing is staged, the ram is cleared by the chip auto write when the ram layout
+ *            is the default one
+ */
+uint8_t ssd1681_clear(ssd1681_handle_t *handle, ssd1681_color_t color)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t j;
+    
+    if (handle == NULL)                                                       /* check handle */
+    {
+        return 2;                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                  /* check handle initialization */
+    {
+        return 3;                                                             /* return error */
+    }
+    
+    for (i = 0; i < 200; i++)                                                 /* x */
+    {
+        for (j = 0; j < 25; j++)                                              /* y */
+        {
+            if (color == SSD1681_COLOR_BLACK)                                 /* if black */
+            {
+                handle->black_gram[i][j] = 0xFF;                              /* set 0xFF */
+            }
+#if (SSD1681_MONOCHROME == 0)
+            else                                                              /* if red */
+            {
+                handle->red_gram[i][j] = 0x00;                                /* set 0x00 */
+            }
+#endif
+        }
+    }
+    if ((handle->force == 0) && ((handle->ram_clear & (1 << color)) != 0))    /* already clear */
+    {
+        if (handle->staged == 0)                                              /* the ram is displayed */
+        {
+            return 0;                                                         /* success return 0 */
+        }
+    }
+    else
+    {
+        res = a_ssd1681_gram_fill(handle, color, SSD1681_STEP_HEIGHT_200, SSD1681_STEP_WIDTH_200,
+                                  (color == SSD1681_COLOR_BLACK) ? 1 : 0);    /* fill the ram on the chip */
+        if (res == 1)                                                         /* check the result */
+        {
+            return 1;                                                         /* return error */
+        }
+        if ((res == 2) && (a_ssd1681_gram_upload(handle, color) != 0))        /* upload the gram */
+        {
+            return 1;                                                         /* return error */
+        }
+    }
+    if (a_ssd1681_gram_activate(handle) != 0)                                 /* activate */
+    {
+        return 1;                                                             /* return error */
+    }
+    handle->ram_clear |= (uint8_t)(1 << color);                               /* flag the ram clear */
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     update the gram data
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram update failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      it is the same as ssd1681_gram_upload followed by ssd1681_gram_activate,
+ *            when the gram matches the controller ram the transfer is skipped and so is the refresh if nothing is staged,
+ *            unless the force update is enabled
+ */
+uint8_t ssd1681_gram_update(ssd1681_handle_t *handle, ssd1681_color_t color)
+{
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    
+    if (a_ssd1681_gram_unchanged(handle, color) != 0)                      /* the ram holds the gram */
+    {
+        if (handle->staged == 0)                                           /* the ram is displayed */
+        {
+            return 0;                                                      /* success return 0 */
+        }
+    }
+    else if (a_ssd1681_gram_upload(handle, color) != 0)                    /* upload the gram */
+    {
+        return 1;                                                          /* return error */
+    }
+    if (a_ssd1681_gram_activate(handle) != 0)                              /* activate */
+    {
+        return 1;                                                          /* return error */
+    }
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     upload the gram data to the controller ram without refreshing the display
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram upload failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the plane stays staged until ssd1681_gram_activate is called,
+ *            the transfer is skipped when the gram matches the controller ram and the force update is disabled
+ */
+uint8_t ssd1681_gram_upload(ssd1681_handle_t *handle, ssd1681_color_t color)
+{
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    
+    if (a_ssd1681_gram_unchanged(handle, color) != 0)                      /* the ram holds the gram */
+    {
+        return 0;                                                          /* success return 0 */
+    }
+    if (a_ssd1681_gram_upload(handle, color) != 0)                         /* upload the gram */
+    {
+        return 1;                                                          /* return error */
+    }
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     fill the controller ram and the gram with a regular pattern
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @param[in] height step height
+ * @param[in] width step width
+ * @param[in] first first step value
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram fill pattern failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 first is over 1 or the step is invalid
+ *            - 5 ram layout is not the default one
+ * @note      the chip writes a checkerboard of height x width steps starting at ram x 0 and y 0,
+ *            a 200 step height gives vertical stripes, a 200 step width gives horizontal stripes
+ *            and both give a solid fill, the plane is staged like after ssd1681_gram_upload
+ */
+uint8_t ssd1681_gram_fill_pattern(ssd1681_handle_t *handle, ssd1681_color_t color,
+                                  ssd1681_step_height_t height, ssd1681_step_width_t width, uint8_t first)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                           /* check handle */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                      /* check handle initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    if (first > 1)                                                                /* check first */
+    {
+        handle->debug_print("ssd1681: first is over 1.\n");                       /* first is over 1 */
+        
+        return 4;                                                                 /* return error */
+    }
+    if (height > SSD1681_STEP_HEIGHT_200)                                         /* check height */
+    {
+        handle->debug_print("ssd1681: height is invalid.\n");                     /* height is invalid */
+        
+        return 4;                                                                 /* return error */
+    }
+    if (width > SSD1681_STEP_WIDTH_200)                                           /* check width */
+    {
+        handle->debug_print("ssd1681: width is invalid.\n");                      /* width is invalid */
+        
+        return 4;                                                                 /* return error */
+    }
+    
+    res = a_ssd1681_gram_fill(handle, color, height, width, first);               /* fill the ram */
+    if (res == 2)                                                                 /* check the layout */
+    {
+        handle->debug_print("ssd1681: ram layout is not the default one.\n");     /* ram layout is not the default one */
+        
+        return 5;                                                                 /* return error */
+    }
+    if (res != 0)                                                                 /* check the result */
+    {
+        return 1;                                                                 /* return error */
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     update the gram data with the dma
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram update failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 dma is busy
+ *            - 5 spi_write_cmd_dma is NULL
+ *            - 6 interface is not 4-wire
+ * @note      it returns after the transfer is started and the gram must not be changed until the dma is done,
+ *            ssd1681_dma_irq_handler must be called in the dma irq and other driver calls fail before that,
+ *            the display is not refreshed, call ssd1681_gram_activate after the dma is done,
+ *            the transfer is never skipped so the dma irq always comes
+ */
+uint8_t ssd1681_gram_update_dma(ssd1681_handle_t *handle, ssd1681_color_t color)
+{
+    uint8_t res;
+    uint8_t buf[2];
+    
+    if (handle == NULL)                                                                                /* check handle */
+    {
+        return 2;                                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                                           /* check handle initialization */
+    {
+        return 3;                                                                                      /* return error */
+    }
+    if (handle->dma_busy != 0)                                                                         /* check the dma */
+    {
+        handle->debug_print("ssd1681: dma is busy.\n");                                                /* dma is busy */
+        
+        return 4;                                                                                      /* return error */
+    }
+    if (handle->spi_write_cmd_dma == NULL)                                                             /* check spi_write_cmd_dma */
+    {
+        handle->debug_print("ssd1681: spi_write_cmd_dma is null.\n");                                  /* spi_write_cmd_dma is null */
+        
+        return 5;                                                                                      /* return error */
+    }
+    if (handle->interface != SSD1681_INTERFACE_4_WIRE)                                                 /* check the interface */
+    {
+        handle->debug_print("ssd1681: interface is not 4-wire.\n");                                    /* interface is not 4-wire */
+        
+        return 6;                                                                                      /* return error */
+    }
+    
+    if (a_ssd1681_power_wake(handle) != 0)                                                             /* wake the chip */
+    {
+        return 1;                                                                                      /* return error */
+    }
+    buf[0] = 0x00;                                                                                     /* set 0x00 */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_X_ADDRESS_COUNTER, buf, 1);        /* write byte */
+    if (res != 0)                                                                                      /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        
+        return 1;                                                                                      /* return error */
+    }
+    buf[0] = 0xC7;                                                                                     /* set 0xC7 */
+    buf[1] = 0x00;                                                                                     /* set 0x00 */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_Y_ADDRESS_COUNTER, buf, 2);        /* write byte */
+    if (res != 0)                                                                                      /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        
+        return 1;                                                                                      /* return error */
+    }
+    res = a_ssd1681_multiple_write_byte(handle, (color == SSD1681_COLOR_BLACK) ?
+                                        SSD1681_CMD_WRITE_RAM_BLACK : SSD1681_CMD_WRITE_RAM_RED,
+                                        NULL, 0);                                                      /* write byte */
+    if (res != 0)                                                                                      /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        
+        return 1;                                                                                      /* return error */
+    }
+    res = handle->spi_cmd_data_gpio_write(SSD1681_DATA);                                               /* write data */
+    if (res != 0)                                                                                      /* check the result */
+    {
+        handle->debug_print("ssd1681: spi cmd data gpio write failed.\n");                             /* spi cmd data gpio write failed */
+        
+        return 1;                                                                                      /* return error */
+    }
+    
+    handle->ram_hash[color] = a_ssd1681_gram_hash(handle, color);                                      /* save the ram hash */
+    if (handle->diff_gram[color] != NULL)                                                              /* if the last frame is kept */
+    {
+        memcpy(handle->diff_gram[color], &SSD1681_GRAM(handle, color)[0][0], 200 * 25);                /* save the last frame */
+    }
+    handle->dma_color = (uint8_t)color;                                                                /* save the color */
+    handle->dma_busy = 1;                                                                              /* set busy */
+    if (color == SSD1681_COLOR_BLACK)                                                                  /* if black */
+    {
+        res = handle->spi_write_cmd_dma(&handle->black_gram[0][0], 200 * 25);                          /* start the dma */
+    }
+    else                                                                                               /* if red */
+    {
+        res = handle->spi_write_cmd_dma(&SSD1681_GRAM(handle, color)[0][0], 200 * 25);                 /* start the dma */
+    }
+    if (res != 0)                                                                                      /* check the result */
+    {
+        handle->dma_busy = 0;                                                                          /* clear busy */
+        handle->debug_print("ssd1681: spi write cmd dma failed.\n");                                   /* spi write cmd dma failed */
+        
+        return 1;                                                                                      /* return error */
+    }
+    
+    return 0;                                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     dma irq handler
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] res transfer result
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_dma_irq_handler(ssd1681_handle_t *handle, uint8_t res)
+{
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (handle->inited != 1)                                            /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    handle->dma_busy = 0;                                               /* clear busy */
+    if (res == 0)                                                       /* check the result */
+    {
+        handle->staged |= (uint8_t)(1 << handle->dma_color);            /* flag the plane staged */
+        handle->ram_hash_valid |= (uint8_t)(1 << handle->dma_color);    /* flag the ram hash */
+        if (handle->diff_gram[handle->dma_color] != NULL)               /* if the last frame is kept */
         {
-            if ((temp & 0x80) != 0)                                                 /* if 1 */
-            {
-                if (a_ssd1681_gram_draw_point(handle, color, x, y, mode) != 0)      /* draw point */
-                {
-                    return 1;                                                       /* return error */
-                }
-            }
-            else 
-            {
-                if (a_ssd1681_gram_draw_point(handle, color, x, y, !mode) != 0)     /* draw point */
-                {
-                    return 1;                                                       /* return error */
-                }
-            }
-            temp <<= 1;                                                             /* left shift 1 */
-            y++;
-            if ((y - y0) == size)                                                   /* reset size */
-            {
-                y = y0;                                                             /* set y */
-                x++;                                                                /* x++ */
-                
-                break;                                                              /* break */
-            }
+            handle->diff_valid |= (uint8_t)(1 << handle->dma_color);    /* flag the last frame */
         }
     }
-  
-    return 0;                                                                       /* success return 0 */
+    if (handle->dma_callback != NULL)                                   /* check the callback */
+    {
+        handle->dma_callback(handle->dma_color, res);                   /* run the callback */
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     refresh the display with the staged controller ram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram activate failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the busy wait is done by the upload, so the refresh starts right after the call,
+ *            all staged planes are cleared
+ */
+uint8_t ssd1681_gram_activate(ssd1681_handle_t *handle)
+{
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    
+    if (a_ssd1681_gram_activate(handle) != 0)                              /* activate */
+    {
+        return 1;                                                          /* return error */
+    }
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     show a page preloaded in the controller ram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] page ram page
+ * @param[in] invert bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 page flip failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      load the pages once with ssd1681_gram_upload of both colors, then a flip only changes the
+ *            display update control ram options and refreshes, nothing is sent to the ram,
+ *            the black page bypasses the red ram, the red page bypasses the black ram and shows the inverse
+ *            red ram so red gram bits set are dark like the black gram bits cleared,
+ *            the black page only uses the lut groups LUT0 (black) and LUT1 (white) and works with any lut,
+ *            the red page reads the black ram as 0 so its pixels use LUT0 (red 0) and LUT2 (red 1),
+ *            it needs a lut that drives LUT2 to white, the otp lut of a red panel drives LUT2 to red
+ *            and the red page is then shown black and red, so it is meant for black and white panels
+ *            with a custom lut loaded by ssd1681_set_lut_register, ssd1681_select_lut or ssd1681_use_waveform,
+ *            call ssd1681_set_display_update_control with the normal options to leave the page mode
+ */
+uint8_t ssd1681_page_flip(ssd1681_handle_t *handle, ssd1681_page_t page, ssd1681_bool_t invert)
+{
+    uint8_t res;
+    uint8_t buf[1];
+    ssd1681_display_control_t control;
+    
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    
+    if (a_ssd1681_power_wake(handle) != 0)                                                      /* wake the chip */
+    {
+        return 1;                                                                               /* return error */
+    }
+    if (page == SSD1681_PAGE_BLACK)                                                             /* black page */
+    {
+        control = (invert == SSD1681_BOOL_TRUE) ? SSD1681_DISPLAY_CONTROL_INVERSE :
+                                                  SSD1681_DISPLAY_CONTROL_NORMAL;               /* black ram option */
+        buf[0] = (uint8_t)((SSD1681_DISPLAY_CONTROL_BYPASS << 4) | (control << 0));             /* bypass the red ram */
+    }
+    else                                                                                        /* red page */
+    {
+        control = (invert == SSD1681_BOOL_TRUE) ? SSD1681_DISPLAY_CONTROL_NORMAL :
+                                                  SSD1681_DISPLAY_CONTROL_INVERSE;              /* red ram option */
+        buf[0] = (uint8_t)((control << 4) | (SSD1681_DISPLAY_CONTROL_BYPASS << 0));             /* bypass the black ram */
+    }
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DISPLAY_UPDATA_CONTROL_1, buf, 1);  /* write byte */
+    if (res != 0)                                                                               /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                          /* multiple write byte failed */
+        
+        return 1;                                                                               /* return error */
+    }
+    if (a_ssd1681_gram_activate(handle) != 0)                                                   /* activate */
+    {
+        return 1;                                                                               /* return error */
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the staged status of a plane
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[in]  color color type
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       a plane is staged after it is uploaded and before the next activation
+ */
+uint8_t ssd1681_gram_get_staged(ssd1681_handle_t *handle, ssd1681_color_t color, ssd1681_bool_t *enable)
+{
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    
+    *enable = (ssd1681_bool_t)((handle->staged >> color) & 0x01);          /* get the staged bit */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief      start a read of a region of the controller ram
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[in]  color color type
+ * @param[in]  x_start start x byte address
+ * @param[in]  x_end end x byte address
+ * @param[in]  y_start start y address
+ * @param[in]  y_end end y address
+ * @param[out] *window pointer to a 6 bytes buffer for the previous ram window
+ * @return     status code
+ *             - 0 success
+ *             - 1 read start failed
+ * @note       the data phase is left open, read it with a_ssd1681_spi_read
+ */
+static uint8_t a_ssd1681_read_ram_begin(ssd1681_handle_t *handle, ssd1681_color_t color,
+                                        uint8_t x_start, uint8_t x_end, uint16_t y_start, uint16_t y_end,
+                                        uint8_t *window)
+{
+    uint8_t res;
+    uint8_t data[4];
+    
+    a_ssd1681_window_get(handle, window);                                                               /* save the ram window */
+    res = a_ssd1681_window_set(handle, x_start, x_end, y_start, y_end);                                 /* set the region */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        return 1;                                                                                       /* return error */
+    }
+    data[0] = (color == SSD1681_COLOR_BLACK) ? SSD1681_READ_RAM_BLACK : SSD1681_READ_RAM_RED;           /* set the ram */
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_READ_RAM_OPTION, data, 1);                  /* write byte */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                  /* multiple write byte failed */
+        
+        return 1;                                                                                       /* return error */
+    }
+    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_READ_RAM, NULL, 0);                         /* write byte */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        handle->debug_print("ssd1681: multiple write byte failed.\n");                                  /* multiple write byte failed */
+        
+        return 1;                                                                                       /* return error */
+    }
+    res = a_ssd1681_spi_read(handle, data, 1);                                                          /* read the dummy byte */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        handle->debug_print("ssd1681: spi read failed.\n");                                             /* spi read failed */
+        
+        return 1;                                                                                       /* return error */
+    }
+    
+    return 0;                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      read a region of the controller ram
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[in]  color color type
+ * @param[in]  x_start start x byte address
+ * @param[in]  x_end end x byte address
+ * @param[in]  y_start start y address
+ * @param[in]  y_end end y address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len region length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the ram window is set back to the previous one after the read
+ */
+static uint8_t a_ssd1681_read_ram_region(ssd1681_handle_t *handle, ssd1681_color_t color,
+                                         uint8_t x_start, uint8_t x_end, uint16_t y_start, uint16_t y_end,
+                                         uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint8_t window[6];
+    
+    res = a_ssd1681_read_ram_begin(handle, color, x_start, x_end, y_start, y_end, window);              /* start the read */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        return 1;                                                                                       /* return error */
+    }
+    res = a_ssd1681_spi_read(handle, buf, len);                                                         /* read the region in bulk */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        handle->debug_print("ssd1681: spi read failed.\n");                                             /* spi read failed */
+        
+        return 1;                                                                                       /* return error */
+    }
+    res = a_ssd1681_window_restore(handle, window);                                                     /* end the read */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        return 1;                                                                                       /* return error */
+    }
+    
+    return 0;                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      read a region of the controller ram in bulk
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[in]  color color type
+ * @param[in]  x_start start x byte address
+ * @param[in]  x_end end x byte address
+ * @param[in]  y_start start y address
+ * @param[in]  y_end end y address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read ram region failed
+ *             - 2 handle or buf is NULL
+ *             - 3 handle is not initialized
+ *             - 4 region is invalid
+ * @note       x_start, x_end <= 0x18 and y_start, y_end <= 0xC7,
+ *             the bytes are stored in the address order of the data entry mode,
+ *             the ram window is set back to the previous one after the read
+ */
+uint8_t ssd1681_read_ram_region(ssd1681_handle_t *handle, ssd1681_color_t color,
+                                uint8_t x_start, uint8_t x_end, uint16_t y_start, uint16_t y_end,
+                                uint8_t *buf, uint32_t len)
+{
+    uint8_t res;
+    uint32_t size;
+    
+    if (handle == NULL)                                                                                 /* check handle */
+    {
+        return 2;                                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                                            /* check handle initialization */
+    {
+        return 3;                                                                                       /* return error */
+    }
+    if (buf == NULL)                                                                                    /* check buf */
+    {
+        handle->debug_print("ssd1681: buf is null.\n");                                                 /* buf is null */
+        
+        return 2;                                                                                       /* return error */
+    }
+    if ((x_start > 0x18) || (x_end > 0x18) || (y_start > 0xC7) || (y_end > 0xC7))                       /* check the region */
+    {
+        handle->debug_print("ssd1681: region is invalid.\n");                                           /* region is invalid */
+        
+        return 4;                                                                                       /* return error */
+    }
+    size = (uint32_t)((x_start > x_end) ? (x_start - x_end) : (x_end - x_start)) + 1;                   /* get the width */
+    size *= (uint32_t)((y_start > y_end) ? (y_start - y_end) : (y_end - y_start)) + 1;                  /* get the size */
+    if (len < size)                                                                                     /* check the length */
+    {
+        handle->debug_print("ssd1681: len is too short.\n");                                            /* len is too short */
+        
+        return 4;                                                                                       /* return error */
+    }
+    
+    res = a_ssd1681_read_ram_region(handle, color, x_start, x_end, y_start, y_end, buf, (uint16_t)size);    /* read the region */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        return 1;                                                                                       /* return error */
+    }
+    
+    return 0;                                                                                           /* success return 0 */
 }
 
 /**
- * @brief     clear the screen
+ * @brief     read the controller ram back into the gram
  * @param[in] *handle pointer to an ssd1681 handle structure
  * @param[in] color color type
  * @return    status code
  *            - 0 success
- *            - 1 clear failed
+ *            - 1 gram read back failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 red gram is not built
+ * @note      the data entry mode must be the one used by the upload,
+ *            red is rejected in the monochrome build because it has no red gram
  */
-uint8_t ssd1681_clear(ssd1681_handle_t *handle, ssd1681_color_t color)
+uint8_t ssd1681_gram_read_back(ssd1681_handle_t *handle, ssd1681_color_t color)
 {
-    uint8_t i;
-    uint8_t j;
     uint8_t res;
-    uint8_t buf[2];
+    uint8_t *gram;
     
-    if (handle == NULL)                                                                                /* check handle */
+    if (handle == NULL)                                                                                 /* check handle */
     {
-        return 2;                                                                                      /* return error */
+        return 2;                                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                                           /* check handle initialization */
+    if (handle->inited != 1)                                                                            /* check handle initialization */
     {
-        return 3;                                                                                      /* return error */
+        return 3;                                                                                       /* return error */
     }
     
-    buf[0] = 0x00;                                                                                     /* set 0x00 */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_X_ADDRESS_COUNTER, buf, 1);        /* write byte */
-    if (res != 0)                                                                                      /* check the result */
+#if (SSD1681_MONOCHROME != 0)
+    if (color != SSD1681_COLOR_BLACK)                                                                   /* check the color */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        handle->debug_print("ssd1681: red gram is not built.\n");                                      /* red gram is not built */
         
-        return 1;                                                                                      /* return error */
+        return 4;                                                                                       /* return error */
     }
-    buf[0] = 0xC7;                                                                                     /* set 0xC7 */
-    buf[1] = 0x00;                                                                                     /* set 0x00 */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_Y_ADDRESS_COUNTER, buf, 2);        /* write byte */
-    if (res != 0)                                                                                      /* check the result */
+#endif
+    
+    gram = &SSD1681_GRAM(handle, color)[0][0];                                                          /* get the gram */
+    res = a_ssd1681_read_ram_region(handle, color, 0x00, 0x18, 0xC7, 0x00, gram, 200 * 25);             /* read the whole ram */
+    if (res != 0)                                                                                       /* check the result */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
-        
-        return 1;                                                                                      /* return error */
+        return 1;                                                                                       /* return error */
     }
-    if (color == SSD1681_COLOR_BLACK)                                                                  /* if black */
+    a_ssd1681_ram_sync(handle, color);                                                                  /* the ram holds the gram */
+    
+    return 0;                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      verify the controller ram against the gram
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[in]  color color type
+ * @param[out] *match pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 gram verify failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the ram is read in small chunks and compared with the gram, the read stops at the first difference,
+ *             the data entry mode must be the one used by the upload
+ */
+uint8_t ssd1681_gram_verify(ssd1681_handle_t *handle, ssd1681_color_t color, ssd1681_bool_t *match)
+{
+    uint8_t res;
+    uint8_t window[6];
+    uint8_t buf[SSD1681_VERIFY_CHUNK_SIZE];
+    uint8_t *gram;
+    uint16_t pos;
+    uint16_t n;
+    
+    if (handle == NULL)                                                                                 /* check handle */
     {
-        res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_RAM_BLACK, NULL, 0);             /* write byte */
-        if (res != 0)                                                                                  /* check the result */
-        {
-            handle->debug_print("ssd1681: multiple write byte failed.\n");                             /* multiple write byte failed */
-            
-            return 1;                                                                                  /* return error */
-        }
-        res = handle->spi_cmd_data_gpio_write(SSD1681_DATA);                                           /* write data */
-        if (res != 0)                                                                                  /* check error */
-        {
-            handle->debug_print("ssd1681: spi cmd data gpio write failed.\n");                         /* spi cmd data gpio write failed */
-            
-            return 1;                                                                                  /* return error */
-        }
-        for (i = 0; i < 200; i++)                                                                      /* x */
-        {
-            for (j = 0; j < 25; j++)                                                                   /* y */
-            {
-                handle->black_gram[i][j] = 0xFF;                                                       /* set 0xFF */
-                res = handle->spi_write_cmd(&handle->black_gram[i][j], 1);                             /* write gram */
-                if (res != 0)                                                                          /* check error */
-                {
-                    handle->debug_print("ssd1681: spi write cmd failed.\n");                           /* spi write cmd failed */
-                    
-                    return 1;                                                                          /* return error */
-                }
-            }
-        }
+        return 2;                                                                                       /* return error */
     }
-    else                                                                                               /* if red */
+    if (handle->inited != 1)                                                                            /* check handle initialization */
     {
-        res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_RAM_RED, NULL, 0);               /* write byte */
-        if (res != 0)                                                                                  /* check the result */
+        return 3;                                                                                       /* return error */
+    }
+    
+    gram = &SSD1681_GRAM(handle, color)[0][0];                                                          /* get the gram */
+    res = a_ssd1681_read_ram_begin(handle, color, 0x00, 0x18, 0xC7, 0x00, window);                      /* start the read */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        return 1;                                                                                       /* return error */
+    }
+    *match = SSD1681_BOOL_TRUE;                                                                         /* init true */
+    for (pos = 0; pos < 200 * 25; pos += n)                                                             /* read all chunks */
+    {
+        n = ((200 * 25 - pos) > SSD1681_VERIFY_CHUNK_SIZE) ? SSD1681_VERIFY_CHUNK_SIZE : (200 * 25 - pos); /* get the chunk size */
+        res = a_ssd1681_spi_read(handle, buf, n);                                                       /* read the chunk */
+        if (res != 0)                                                                                   /* check the result */
         {
-            handle->debug_print("ssd1681: multiple write byte failed.\n");                             /* multiple write byte failed */
+            handle->debug_print("ssd1681: spi read failed.\n");                                         /* spi read failed */
             
-            return 1;                                                                                  /* return error */
+            return 1;                                                                                   /* return error */
         }
-        res = handle->spi_cmd_data_gpio_write(SSD1681_DATA);                                           /* write data */
-        if (res != 0)                                                                                  /* check error */
+        if (memcmp(buf, gram + pos, n) != 0)                                                            /* check the chunk */
         {
-            handle->debug_print("ssd1681: spi cmd data gpio write failed.\n");                         /* spi cmd data gpio write failed */
+            *match = SSD1681_BOOL_FALSE;                                                                /* set false */
             
-            return 1;                                                                                  /* return error */
-        }
-        for (i = 0; i < 200; i++)                                                                      /* x */
-        {
-            for (j = 0; j < 25; j++)                                                                   /* y */
-            {
-                handle->red_gram[i][j] = 0x00;                                                         /* set 0x00 */
-                res = handle->spi_write_cmd(&handle->red_gram[i][j], 1);                               /* write gram */
-                if (res != 0)                                                                          /* check error */
-                {
-                    handle->debug_print("ssd1681: spi write cmd failed.\n");                           /* spi write cmd failed */
-                    
-                    return 1;                                                                          /* return error */
-                }
-            }
+            break;                                                                                      /* break */
         }
     }
+    res = a_ssd1681_window_restore(handle, window);                                                     /* end the read */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        return 1;                                                                                       /* return error */
+    }
+    if (*match == SSD1681_BOOL_TRUE)                                                                    /* if matched */
+    {
+        a_ssd1681_ram_sync(handle, color);                                                              /* the ram holds the gram */
+    }
     
-    buf[0] = 0xF7;                                                                                     /* set 0xF7 */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DISPLAY_UPDATA_CONTROL_2, buf, 1);         /* write byte */
-    if (res != 0)                                                                                      /* check the result */
+    return 0;                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     restore the gram from a snapshot of the controller ram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @param[in] *buf pointer to a snapshot buffer
+ * @param[in] len snapshot length
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram restore failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 snapshot is invalid
+ *            - 5 red gram is not built
+ * @note      the snapshot must be a copy of the gram taken after its last upload,
+ *            nothing is sent to the chip, red is rejected in the monochrome build
+ */
+uint8_t ssd1681_gram_restore(ssd1681_handle_t *handle, ssd1681_color_t color, const uint8_t *buf, uint16_t len)
+{
+    if (handle == NULL)                                                           /* check handle */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        return 2;                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                      /* check handle initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    if ((buf == NULL) || (len != 200 * 25))                                       /* check the snapshot */
+    {
+        handle->debug_print("ssd1681: snapshot is invalid.\n");                   /* snapshot is invalid */
         
-        return 1;                                                                                      /* return error */
+        return 4;                                                                 /* return error */
     }
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_MASTER_ACTIVATION, NULL, 0);               /* write byte */
-    if (res != 0)                                                                                      /* check the result */
+#if (SSD1681_MONOCHROME != 0)
+    if (color != SSD1681_COLOR_BLACK)                                             /* check the color */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        handle->debug_print("ssd1681: red gram is not built.\n");                /* red gram is not built */
         
-        return 1;                                                                                      /* return error */
+        return 5;                                                                 /* return error */
     }
+#endif
     
-    return 0;                                                                                          /* success return 0 */
+    memcpy(&SSD1681_GRAM(handle, color)[0][0], buf, len);                         /* copy the snapshot */
+    a_ssd1681_ram_sync(handle, color);                                            /* the ram holds the gram */
+    
+    return 0;                                                                     /* success return 0 */
 }
 
 /**
- * @brief     update the gram data
+ * @brief     enable or disable the burst refresh mode
  * @param[in] *handle pointer to an ssd1681 handle structure
- * @param[in] color color type
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 gram update failed
+ *            - 1 set burst failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      enabling powers up the clock and analog circuits and loads the temperature and the lut once,
+ *            then every activation only runs the display step until the burst is disabled,
+ *            disabling runs the power down step of the full sequence
  */
-uint8_t ssd1681_gram_update(ssd1681_handle_t *handle, ssd1681_color_t color)
+uint8_t ssd1681_set_burst(ssd1681_handle_t *handle, ssd1681_bool_t enable)
 {
-    uint8_t i;
-    uint8_t j;
     uint8_t res;
-    uint8_t buf[2];
     
-    if (handle == NULL)                                                                                /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                                      /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                                           /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                                      /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    buf[0] = 0x00;                                                                                     /* set 0x00 */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_X_ADDRESS_COUNTER, buf, 1);        /* write byte */
-    if (res != 0)                                                                                      /* check the result */
+    if (enable == (ssd1681_bool_t)handle->burst)                                          /* check the mode */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
-        
-        return 1;                                                                                      /* return error */
+        return 0;                                                                         /* success return 0 */
     }
-    buf[0] = 0xC7;                                                                                     /* set 0xC7 */
-    buf[1] = 0x00;                                                                                     /* set 0x00 */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_SET_RAM_Y_ADDRESS_COUNTER, buf, 2);        /* write byte */
-    if (res != 0)                                                                                      /* check the result */
+    if (enable == SSD1681_BOOL_TRUE)                                                      /* enable */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
-        
-        return 1;                                                                                      /* return error */
+        res = a_ssd1681_run_sequence(handle, SSD1681_SEQUENCE_BURST_START);               /* power up */
     }
-    if (color == SSD1681_COLOR_BLACK)                                                                  /* if black */
+    else                                                                                  /* disable */
     {
-        res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_RAM_BLACK, NULL, 0);             /* write byte */
-        if (res != 0)                                                                                  /* check the result */
-        {
-            handle->debug_print("ssd1681: multiple write byte failed.\n");                             /* multiple write byte failed */
-            
-            return 1;                                                                                  /* return error */
-        }
-        res = handle->spi_cmd_data_gpio_write(SSD1681_DATA);                                           /* write data */
-        if (res != 0)                                                                                  /* check error */
-        {
-            handle->debug_print("ssd1681: spi cmd data gpio write failed.\n");                         /* spi cmd data gpio write failed */
-            
-            return 1;                                                                                  /* return error */
-        }
-        for (i = 0; i < 200; i++)                                                                      /* x */
-        {
-            for (j = 0; j < 25; j++)                                                                   /* y */
-            {
-                res = handle->spi_write_cmd(&handle->black_gram[i][j], 1);                             /* write gram */
-                if (res != 0)                                                                          /* check error */
-                {
-                    handle->debug_print("ssd1681: spi write cmd failed.\n");                           /* spi write cmd failed */
-                    
-                    return 1;                                                                          /* return error */
-                }
-            }
-        }
+        res = a_ssd1681_run_sequence(handle, SSD1681_SEQUENCE_BURST_END);                 /* power down */
     }
-    else                                                                                               /* if red */
+    if (res != 0)                                                                         /* check the result */
+    {
+        return 1;                                                                         /* return error */
+    }
+    handle->burst = (uint8_t)enable;                                                      /* save the mode */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      get the burst refresh mode
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ssd1681_get_burst(ssd1681_handle_t *handle, ssd1681_bool_t *enable)
+{
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    
+    *enable = (ssd1681_bool_t)(handle->burst);                                            /* get the mode */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the force update
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      by default an update whose gram matches the controller ram skips the transfer and the refresh,
+ *            enabling the force update always sends and refreshes
+ */
+uint8_t ssd1681_set_force_update(ssd1681_handle_t *handle, ssd1681_bool_t enable)
+{
+    if (handle == NULL)                                            /* check handle */
+    {
+        return 2;                                                  /* return error */
+    }
+    if (handle->inited != 1)                                       /* check handle initialization */
+    {
+        return 3;                                                  /* return error */
+    }
+    
+    handle->force = (uint8_t)enable;                               /* save the flag */
+    
+    return 0;                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the force update status
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ssd1681_get_force_update(ssd1681_handle_t *handle, ssd1681_bool_t *enable)
+{
+    if (handle == NULL)                                            /* check handle */
+    {
+        return 2;                                                  /* return error */
+    }
+    if (handle->inited != 1)                                       /* check handle initialization */
     {
-        res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_WRITE_RAM_RED, NULL, 0);               /* write byte */
-        if (res != 0)                                                                                  /* check the result */
-        {
-            handle->debug_print("ssd1681: multiple write byte failed.\n");                             /* multiple write byte failed */
-            
-            return 1;                                                                                  /* return error */
-        }
-        res = handle->spi_cmd_data_gpio_write(SSD1681_DATA);                                           /* write data */
-        if (res != 0)                                                                                  /* check error */
-        {
-            handle->debug_print("ssd1681: spi cmd data gpio write failed.\n");                         /* spi cmd data gpio write failed */
-            
-            return 1;                                                                                  /* return error */
-        }
-        for (i = 0; i < 200; i++)                                                                      /* x */
-        {
-            for (j = 0; j < 25; j++)                                                                   /* y */
-            {
-                res = handle->spi_write_cmd(&handle->red_gram[i][j], 1);                               /* write gram */
-                if (res != 0)                                                                          /* check error */
-                {
-                    handle->debug_print("ssd1681: spi write cmd failed.\n");                           /* spi write cmd failed */
-                    
-                    return 1;                                                                          /* return error */
-                }
-            }
-        }
+        return 3;                                                  /* return error */
     }
     
-    buf[0] = 0xF7;                                                                                     /* set 0xF7 */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DISPLAY_UPDATA_CONTROL_2, buf, 1);         /* write byte */
-    if (res != 0)                                                                                      /* check the result */
+    *enable = (ssd1681_bool_t)(handle->force);                     /* get the flag */
+    
+    return 0;                                                      /* success return 0 */
+}
+
+/**
+ * @brief     set the last frame buffer of a plane
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @param[in] *buf pointer to a 5000 bytes buffer, NULL disables it
+ * @param[in] len buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 len is invalid
+ *            - 5 color is invalid
+ * @note      the driver keeps a copy of the last uploaded frame in the buffer and the next upload
+ *            only sends the rows that changed, the first upload after setting it is a full one
+ */
+uint8_t ssd1681_set_diff_buffer(ssd1681_handle_t *handle, ssd1681_color_t color, uint8_t *buf, uint16_t len)
+{
+    if (handle == NULL)                                                    /* check handle */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        return 2;                                                          /* return error */
+    }
+    if (handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    if ((buf != NULL) && (len != 200 * 25))                                /* check the length */
+    {
+        handle->debug_print("ssd1681: len is invalid.\n");                  /* len is invalid */
         
-        return 1;                                                                                      /* return error */
+        return 4;                                                          /* return error */
     }
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_MASTER_ACTIVATION, NULL, 0);               /* write byte */
-    if (res != 0)                                                                                      /* check the result */
+    if ((color != SSD1681_COLOR_BLACK) && (color != SSD1681_COLOR_RED))    /* check the color */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                                 /* multiple write byte failed */
+        handle->debug_print("ssd1681: color is invalid.\n");                /* color is invalid */
         
-        return 1;                                                                                      /* return error */
+        return 5;                                                          /* return error */
     }
     
-    return 0;                                                                                          /* success return 0 */
+    handle->diff_gram[color] = buf;                                        /* save the buffer */
+    handle->diff_valid &= (uint8_t)(~(1 << color));                        /* the last frame is unknown */
+    
+    return 0;                                                              /* success return 0 */
 }
 
 /**
@@ -2512,6 +5147,7 @@ uint8_t ssd1681_gram_clear(ssd1681_handle_t *handle, ssd1681_color_t color)
             }
         }
     }
+#if (SSD1681_MONOCHROME == 0)
     else                                                /* if red */
     {
         for (i = 0; i < 200; i++)                       /* x */
@@ -2522,6 +5158,7 @@ uint8_t ssd1681_gram_clear(ssd1681_handle_t *handle, ssd1681_color_t color)
             }
         }
     }
+#endif
     
     return 0;                                           /* success return 0 */
 }
@@ -2576,6 +5213,7 @@ uint8_t ssd1681_gram_write_point(ssd1681_handle_t *handle, ssd1681_color_t color
             handle->black_gram[x][pos] &= ~temp;                     /* set 0 */
         }
     }
+#if (SSD1681_MONOCHROME == 0)
     else                                                             /* if red */
     {
         if (data != 0)                                               /* if 1 */
@@ -2587,6 +5225,7 @@ uint8_t ssd1681_gram_write_point(ssd1681_handle_t *handle, ssd1681_color_t color
             handle->red_gram[x][pos] &= ~temp;                       /* set 0 */
         }
     }
+#endif
   
     return 0;                                                        /* success return 0 */
 }
@@ -2643,6 +5282,7 @@ uint8_t ssd1681_gram_read_point(ssd1681_handle_t *handle, ssd1681_color_t color,
     }
     else                                                             /* if red */
     {
+#if (SSD1681_MONOCHROME == 0)
         if ((handle->red_gram[x][pos] & temp) != 0)                  /* get data */
         {
             *data = 1;                                               /* set 1 */
@@ -2651,6 +5291,9 @@ uint8_t ssd1681_gram_read_point(ssd1681_handle_t *handle, ssd1681_color_t color,
         {
             *data = 0;                                               /* set 0 */
         }
+#else
+        *data = 0;                                                   /* no red gram */
+#endif
     }
   
     return 0;                                                        /* success return 0 */
@@ -2844,8 +5487,144 @@ uint8_t ssd1681_gram_draw_picture(ssd1681_handle_t *handle, ssd1681_color_t colo
 }
 
 /**
- * @brief     initialize the chip
+ * @brief     deinit the command/data gpio when it is used
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @note      none
+ */
+static void a_ssd1681_cmd_data_gpio_deinit(ssd1681_handle_t *handle)
+{
+    if (handle->interface == SSD1681_INTERFACE_4_WIRE)                              /* 4-wire */
+    {
+        (void)handle->spi_cmd_data_gpio_deinit();                                   /* spi_cmd_data_gpio_deinit */
+    }
+}
+
+/**
+ * @brief     set the chip interface
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] interface chip interface
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      it must be called before ssd1681_init
+ *            in the 3-wire mode the command/data gpio is not used and its link functions can be NULL
+ */
+uint8_t ssd1681_set_interface(ssd1681_handle_t *handle, ssd1681_interface_t interface)
+{
+    if (handle == NULL)                                                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    
+    handle->interface = (uint8_t)interface;                                         /* set the interface */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the chip interface
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *interface pointer to a chip interface buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ssd1681_get_interface(ssd1681_handle_t *handle, ssd1681_interface_t *interface)
+{
+    if (handle == NULL)                                                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    
+    *interface = (ssd1681_interface_t)(handle->interface);                          /* get the interface */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     set the busy wait mode
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] mode busy wait mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 busy_gpio_wait is NULL
+ * @note      the irq mode needs the busy_gpio_wait link function
+ */
+uint8_t ssd1681_set_busy_mode(ssd1681_handle_t *handle, ssd1681_busy_mode_t mode)
+{
+    if (handle == NULL)                                                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if ((mode == SSD1681_BUSY_MODE_IRQ) && (handle->busy_gpio_wait == NULL))        /* check busy_gpio_wait */
+    {
+        return 4;                                                                   /* return error */
+    }
+    
+    handle->busy_mode = (uint8_t)mode;                                              /* set the mode */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the busy wait mode
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *mode pointer to a busy wait mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ssd1681_get_busy_mode(ssd1681_handle_t *handle, ssd1681_busy_mode_t *mode)
+{
+    if (handle == NULL)                                                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    
+    *mode = (ssd1681_busy_mode_t)(handle->busy_mode);                               /* get the mode */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the predicted busy time of the last operation
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *ms pointer to a predicted time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       ms is 0 if the operation has not been measured yet,
+ *             an operation is keyed by the command, the display sequence, the lut and the temperature band
+ */
+uint8_t ssd1681_get_busy_prediction(ssd1681_handle_t *handle, uint32_t *ms)
+{
+    uint8_t i;
+    
+    if (handle == NULL)                                                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    
+    i = a_ssd1681_busy_find(handle, a_ssd1681_busy_key(handle));                    /* find the prediction */
+    if (i == SSD1681_BUSY_PREDICT_NUM)                                              /* if not found */
+    {
+        *ms = 0;                                                                    /* unknown */
+    }
+    else
+    {
+        *ms = handle->busy_predict[i].ms;                                           /* get the time */
+    }
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     open the chip
  * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] reset reset the chip or keep its state
  * @return    status code
  *            - 0 success
  *            - 1 spi initialization failed
@@ -2855,8 +5634,10 @@ uint8_t ssd1681_gram_draw_picture(ssd1681_handle_t *handle, ssd1681_color_t colo
  *            - 5 gpio init failed
  * @note      none
  */
-uint8_t ssd1681_init(ssd1681_handle_t *handle)
+static uint8_t a_ssd1681_open(ssd1681_handle_t *handle, uint8_t reset)
 {
+    uint8_t res;
+    
     if (handle == NULL)                                                             /* check handle */
     {
         return 2;                                                                   /* return error */
@@ -2889,23 +5670,26 @@ uint8_t ssd1681_init(ssd1681_handle_t *handle)
         
         return 3;                                                                   /* return error */
     }
-    if (handle->spi_cmd_data_gpio_init == NULL)                                     /* check spi_cmd_data_gpio_init */
-    {
-        handle->debug_print("ssd1681: spi_cmd_data_gpio_init is null.\n");          /* spi_cmd_data_gpio_init is null */
-       
-        return 3;                                                                   /* return error */
-    }
-    if (handle->spi_cmd_data_gpio_deinit == NULL)                                   /* check spi_cmd_data_gpio_deinit */
-    {
-        handle->debug_print("ssd1681: spi_cmd_data_gpio_deinit is null.\n");        /* spi_cmd_data_gpio_deinit is null */
-       
-        return 3;                                                                   /* return error */
-    }
-    if (handle->spi_cmd_data_gpio_write == NULL)                                    /* check spi_cmd_data_gpio_write */
+    if (handle->interface == SSD1681_INTERFACE_4_WIRE)                              /* 4-wire uses the command/data gpio */
     {
-        handle->debug_print("ssd1681: spi_cmd_data_gpio_write is null.\n");         /* spi_cmd_data_gpio_write is null */
-        
-        return 3;                                                                   /* return error */
+        if (handle->spi_cmd_data_gpio_init == NULL)                                 /* check spi_cmd_data_gpio_init */
+        {
+            handle->debug_print("ssd1681: spi_cmd_data_gpio_init is null.\n");      /* spi_cmd_data_gpio_init is null */
+           
+            return 3;                                                               /* return error */
+        }
+        if (handle->spi_cmd_data_gpio_deinit == NULL)                               /* check spi_cmd_data_gpio_deinit */
+        {
+            handle->debug_print("ssd1681: spi_cmd_data_gpio_deinit is null.\n");    /* spi_cmd_data_gpio_deinit is null */
+           
+            return 3;                                                               /* return error */
+        }
+        if (handle->spi_cmd_data_gpio_write == NULL)                                /* check spi_cmd_data_gpio_write */
+        {
+            handle->debug_print("ssd1681: spi_cmd_data_gpio_write is null.\n");     /* spi_cmd_data_gpio_write is null */
+            
+            return 3;                                                               /* return error */
+        }
     }
     if (handle->reset_gpio_init == NULL)                                            /* check reset_gpio_init */
     {
@@ -2943,65 +5727,141 @@ uint8_t ssd1681_init(ssd1681_handle_t *handle)
         
         return 3;                                                                   /* return error */
     }
-    
-    if (handle->spi_cmd_data_gpio_init() != 0)                                      /* check spi_cmd_data_gpio_init */
+#if (SSD1681_EMBEDDED_GRAM != 0)
+    if (handle->black_gram == NULL)                                                 /* check black_gram */
     {
-        handle->debug_print("ssd1681: spi cmd data gpio init failed.\n");           /* spi cmd data gpio init failed */
+        handle->black_gram = handle->black_gram_buf;                                /* use the embedded gram */
+    }
+#if (SSD1681_MONOCHROME == 0)
+    if (handle->red_gram == NULL)                                                   /* check red_gram */
+    {
+        handle->red_gram = handle->red_gram_buf;                                    /* use the embedded gram */
+    }
+#endif
+#endif
+    if ((handle->black_gram == NULL) || (SSD1681_GRAM(handle, SSD1681_COLOR_RED) == NULL))    /* check the gram */
+    {
+        handle->debug_print("ssd1681: gram is null.\n");                            /* gram is null */
         
-        return 5;                                                                   /* return error */
+        return 3;                                                                   /* return error */
+    }
+    
+    if (handle->interface == SSD1681_INTERFACE_4_WIRE)                              /* 4-wire */
+    {
+        if (handle->spi_cmd_data_gpio_init() != 0)                                  /* check spi_cmd_data_gpio_init */
+        {
+            handle->debug_print("ssd1681: spi cmd data gpio init failed.\n");       /* spi cmd data gpio init failed */
+            
+            return 5;                                                               /* return error */
+        }
     }
     if (handle->reset_gpio_init() != 0)                                             /* reset gpio init */
     {
         handle->debug_print("ssd1681: reset gpio init failed.\n");                  /* reset gpio init failed */
-        (void)handle->spi_cmd_data_gpio_deinit();                                   /* spi_cmd_data_gpio_deinit */
+        a_ssd1681_cmd_data_gpio_deinit(handle);                                     /* spi_cmd_data_gpio_deinit */
         
         return 5;                                                                   /* return error */
     }
     if (handle->busy_gpio_init() != 0)                                              /* busy gpio init */
     {
         handle->debug_print("ssd1681: busy gpio init failed.\n");                   /* busy gpio init failed */
-        (void)handle->spi_cmd_data_gpio_deinit();                                   /* spi_cmd_data_gpio_deinit */
+        a_ssd1681_cmd_data_gpio_deinit(handle);                                     /* spi_cmd_data_gpio_deinit */
         (void)handle->reset_gpio_deinit();                                          /* reset_gpio_deinit */
         
         return 5;                                                                   /* return error */
     }
     
-    if (handle->reset_gpio_write(0) != 0)                                           /* write 0 */
+    if (reset != 0)                                                                 /* if reset */
     {
-        handle->debug_print("ssd1681: reset gpio write failed.\n");                 /* reset gpio write failed */
-        (void)handle->spi_cmd_data_gpio_deinit();                                   /* spi_cmd_data_gpio_deinit */
-        (void)handle->reset_gpio_deinit();                                          /* reset_gpio_deinit */
-        (void)handle->busy_gpio_deinit();                                           /* busy_gpio_deinit */
-        
-        return 4;                                                                   /* return error */
+        res = a_ssd1681_hardware_reset(handle);                                     /* hardware reset */
     }
-    handle->delay_ms(10);                                                           /* delay 10 ms */
-    if (handle->reset_gpio_write(1) != 0)                                           /* write 1 */
+    else
     {
-        handle->debug_print("ssd1681: reset gpio write failed.\n");                 /* reset gpio write failed */
-        (void)handle->spi_cmd_data_gpio_deinit();                                   /* spi_cmd_data_gpio_deinit */
+        res = a_ssd1681_busy_wait(handle);                                          /* wait the running operation */
+        if (res != 0)                                                               /* check the result */
+        {
+            handle->debug_print("ssd1681: busy wait failed.\n");                    /* busy wait failed */
+        }
+    }
+    if (res != 0)                                                                   /* check the result */
+    {
+        a_ssd1681_cmd_data_gpio_deinit(handle);                                     /* spi_cmd_data_gpio_deinit */
         (void)handle->reset_gpio_deinit();                                          /* reset_gpio_deinit */
         (void)handle->busy_gpio_deinit();                                           /* busy_gpio_deinit */
         
         return 4;                                                                   /* return error */
     }
-    handle->delay_ms(200);                                                          /* delay 200 ms */
 
     if (handle->spi_init() != 0)                                                    /* spi init */
     {
         handle->debug_print("ssd1681: spi init failed.\n");                         /* spi init failed */
-        (void)handle->spi_cmd_data_gpio_deinit();                                   /* spi_cmd_data_gpio_deinit */
+        a_ssd1681_cmd_data_gpio_deinit(handle);                                     /* spi_cmd_data_gpio_deinit */
         (void)handle->reset_gpio_deinit();                                          /* reset_gpio_deinit */
         (void)handle->busy_gpio_deinit();                                           /* busy_gpio_deinit */
         
         return 1;                                                                   /* return error */
     }
 
+    handle->dma_busy = 0;                                                           /* clear dma busy */
+    handle->burst = 0;                                                              /* clear the burst */
+    handle->lut = NULL;                                                             /* the lut is unknown */
+    handle->lut_loaded = 0;                                                         /* the otp lut is used */
+    handle->shadow_valid = 0;                                                       /* the registers are unknown */
+    handle->shadow_saved = 0;                                                       /* nothing to resume */
+    handle->lut_saved = NULL;                                                       /* no lut to resume */
+    handle->sleeping = 0;                                                           /* the chip is awake */
+    handle->power_enable = 0;                                                       /* disable the power manager */
+    handle->power_mode = SSD1681_MODE_DEEP_SLEEP_1;                                 /* deep sleep mode 1 */
+    handle->power_idle_time = 0;                                                    /* no idle time */
+    handle->power_idle = 0;                                                         /* clear the idle time */
+    handle->power_awake_ms = 0;                                                     /* clear the awake time */
+    handle->power_sleep_ms = 0;                                                     /* clear the sleep time */
+    handle->power_wake_count = 0;                                                   /* clear the wake count */
+    handle->staged = 0;                                                             /* nothing staged */
+    handle->ram_clear = 0;                                                          /* the ram is unknown */
+    handle->ram_hash_valid = 0;                                                     /* the ram hash is unknown */
+    handle->force = 0;                                                              /* no force update */
+    handle->diff_valid = 0;                                                         /* the last frame is unknown */
     handle->inited = 1;                                                             /* flag inited */
     
     return 0;                                                                       /* success return 0 */
 }
 
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 reset failed
+ *            - 5 gpio init failed
+ * @note      the reset waits on the busy pin instead of a fixed delay
+ */
+uint8_t ssd1681_init(ssd1681_handle_t *handle)
+{
+    return a_ssd1681_open(handle, 1);        /* open with the reset */
+}
+
+/**
+ * @brief     attach to a running chip without the reset
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 busy wait failed
+ *            - 5 gpio init failed
+ * @note      the chip keeps its registers, lut and ram, it must not be in the deep sleep,
+ *            use ssd1681_gram_read_back or ssd1681_gram_restore to get the gram back
+ */
+uint8_t ssd1681_attach(ssd1681_handle_t *handle)
+{
+    return a_ssd1681_open(handle, 0);        /* open without the reset */
+}
+
 /**
  * @brief     close the chip
  * @param[in] *handle pointer to an ssd1681 handle structure
@@ -3030,15 +5890,27 @@ uint8_t ssd1681_deinit(ssd1681_handle_t *handle)
         return 3;                                                                             /* return error */
     }
     
-    buf[0] = 0x01;                                                                            /* set 0x01 */
-    res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DEEP_SLEEP_MODE, buf, 1);         /* write byte */
-    if (res != 0)                                                                             /* check the result */
+    if (handle->sleeping == 0)                                                                /* if awake */
     {
-        handle->debug_print("ssd1681: multiple write byte failed.\n");                        /* multiple write byte failed */
-        
-        return 4;                                                                             /* return error */
+        if (handle->burst != 0)                                                               /* if burst */
+        {
+            res = a_ssd1681_run_sequence(handle, SSD1681_SEQUENCE_BURST_END);                 /* power down */
+            if (res != 0)                                                                     /* check the result */
+            {
+                return 4;                                                                     /* return error */
+            }
+            handle->burst = 0;                                                                /* clear the burst */
+        }
+        buf[0] = 0x01;                                                                        /* set 0x01 */
+        res = a_ssd1681_multiple_write_byte(handle, SSD1681_CMD_DEEP_SLEEP_MODE, buf, 1);     /* write byte */
+        if (res != 0)                                                                         /* check the result */
+        {
+            handle->debug_print("ssd1681: multiple write byte failed.\n");                    /* multiple write byte failed */
+            
+            return 4;                                                                         /* return error */
+        }
+        handle->delay_ms(100);                                                                /* delay 100 ms */
     }
-    handle->delay_ms(100);                                                                    /* delay 100 ms */
     
     if (handle->reset_gpio_deinit() != 0)                                                     /* reset gpio deinit */
     {
@@ -3046,7 +5918,8 @@ uint8_t ssd1681_deinit(ssd1681_handle_t *handle)
             
         return 5;                                                                             /* return error */
     }
-    if (handle->spi_cmd_data_gpio_deinit() != 0)                                              /* spi cmd data gpio deinit */
+    if ((handle->interface == SSD1681_INTERFACE_4_WIRE) &&
+        (handle->spi_cmd_data_gpio_deinit() != 0))                                            /* spi cmd data gpio deinit */
     {
         handle->debug_print("ssd1681: spi cmd data gpio deinit failed.\n");                   /* spi cmd data gpio deinit failed */
             
@@ -3081,7 +5954,9 @@ uint8_t ssd1681_deinit(ssd1681_handle_t *handle)
  *            - 1 write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the shadow registers, the loaded lut and the ram state are dropped,
+ *            a reset, deep sleep, activation or lut write command also updates the staged planes,
+ *            the sleep flag and the lut kept by the refresh and the resume
  */
 uint8_t ssd1681_write_cmd(ssd1681_handle_t *handle, uint8_t *buf, uint8_t len)
 {
@@ -3097,18 +5972,38 @@ uint8_t ssd1681_write_cmd(ssd1681_handle_t *handle, uint8_t *buf, uint8_t len)
         return 3;                                                  /* return error */
     }
     
-    res = handle->spi_cmd_data_gpio_write(SSD1681_CMD);            /* write command */
-    if (res != 0)                                                  /* check error */
+    handle->shadow_valid = 0;                                      /* the registers are unknown */
+    handle->lut = NULL;                                            /* the lut is unknown */
+    handle->ram_clear = 0;                                         /* the ram is unknown */
+    handle->ram_hash_valid = 0;                                    /* the ram hash is unknown */
+    handle->diff_valid = 0;                                        /* the last frame is unknown */
+    for (i = 0; i < len; i++)                                      /* check the commands */
     {
-        return 1;                                                  /* return error */
-    }
-    for (i = 0; i < len; i++)                                      /* len times */
-    {
-        if (handle->spi_write_cmd(buf + i, 1) != 0)                /* write command */
+        if ((buf[i] == SSD1681_CMD_SW_RESET) || 
+            (buf[i] == SSD1681_CMD_DEEP_SLEEP_MODE))               /* reset or deep sleep */
         {
-            return 1;                                              /* return error */
+            handle->staged = 0;                                    /* the ram may be lost */
+            handle->burst = 0;                                     /* the analog is off */
+            handle->lut_loaded = 0;                                /* the lut register is lost */
+            handle->sleeping = (buf[i] == SSD1681_CMD_DEEP_SLEEP_MODE) ? 1 : 0;    /* resume before the next use */
+        }
+        else if (buf[i] == SSD1681_CMD_MASTER_ACTIVATION)          /* activation */
+        {
+            handle->staged = 0;                                    /* the planes are shown */
+            handle->lut_loaded = 0;                                /* the otp lut may be loaded */
+            handle->lut_saved = NULL;                              /* the lut may be replaced */
+        }
+        else if (buf[i] == SSD1681_CMD_WRITE_LUT_REGISTER)         /* lut is written */
+        {
+            handle->lut_loaded = 1;                                /* keep it on the refresh */
+            handle->lut_saved = NULL;                              /* not replayed by the resume */
         }
     }
+    res = a_ssd1681_spi_write(handle, SSD1681_CMD, buf, len);      /* write command */
+    if (res != 0)                                                  /* check error */
+    {
+        return 1;                                                  /* return error */
+    }
     
     return 0;                                                      /* success return 0 */
 }
@@ -3128,7 +6023,6 @@ uint8_t ssd1681_write_cmd(ssd1681_handle_t *handle, uint8_t *buf, uint8_t len)
 uint8_t ssd1681_write_data(ssd1681_handle_t *handle, uint8_t *buf, uint8_t len)
 {
     uint8_t res;
-    uint8_t i;
     
     if (handle == NULL)                                            /* check handle */
     {
@@ -3139,18 +6033,11 @@ uint8_t ssd1681_write_data(ssd1681_handle_t *handle, uint8_t *buf, uint8_t len)
         return 3;                                                  /* return error */
     }
     
-    res = handle->spi_cmd_data_gpio_write(SSD1681_DATA);           /* write data */
+    res = a_ssd1681_spi_write(handle, SSD1681_DATA, buf, len);     /* write data */
     if (res != 0)                                                  /* check error */
     {
         return 1;                                                  /* return error */
     }
-    for (i = 0; i < len; i++)                                      /* len times */
-    {
-        if (handle->spi_write_cmd(buf + i, 1) != 0)                /* write command */
-        {
-            return 1;                                              /* return error */
-        }
-    }
     
     return 0;                                                      /* success return 0 */
 }
@@ -3170,7 +6057,6 @@ uint8_t ssd1681_write_data(ssd1681_handle_t *handle, uint8_t *buf, uint8_t len)
 uint8_t ssd1681_read_data(ssd1681_handle_t *handle, uint8_t *buf, uint8_t len)
 {
     uint8_t res;
-    uint8_t i;
     
     if (handle == NULL)                                            /* check handle */
     {
@@ -3181,18 +6067,11 @@ uint8_t ssd1681_read_data(ssd1681_handle_t *handle, uint8_t *buf, uint8_t len)
         return 3;                                                  /* return error */
     }
     
-    res = handle->spi_cmd_data_gpio_write(SSD1681_DATA);           /* write data */
+    res = a_ssd1681_spi_read(handle, buf, len);                    /* read data */
     if (res != 0)                                                  /* check error */
     {
         return 1;                                                  /* return error */
     }
-    for (i = 0; i < len; i++)                                      /* len times */
-    {
-        if (handle->spi_read_cmd(buf + i, 1) != 0)                 /* read command */
-        {
-            return 1;                                              /* return error */
-        }
-    }
     
     return 0;                                                      /* success return 0 */
 }
@@ -56,6 +56,65 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief ssd1681 reset pulse definition
+ */
+#ifndef SSD1681_RESET_PULSE_MS
+    #define SSD1681_RESET_PULSE_MS           10        /**< 10ms */
+#endif
+
+/**
+ * @brief ssd1681 reset release definition
+ * @note  the busy pin goes high a short time after the reset is released
+ */
+#ifndef SSD1681_RESET_RELEASE_MS
+    #define SSD1681_RESET_RELEASE_MS         10        /**< 10ms */
+#endif
+
+/**
+ * @brief ssd1681 init record max length definition
+ */
+#ifndef SSD1681_INIT_RECORD_MAX_LEN
+    #define SSD1681_INIT_RECORD_MAX_LEN      10        /**< 10 bytes */
+#endif
+
+/**
+ * @brief ssd1681 embedded gram definition
+ */
+#ifndef SSD1681_EMBEDDED_GRAM
+    #define SSD1681_EMBEDDED_GRAM            1         /**< 1 embeds the gram in the handle, 0 needs DRIVER_SSD1681_LINK_GRAM */
+#endif
+
+/**
+ * @brief ssd1681 monochrome definition
+ * @note  1 drops the red gram, red drawing is ignored and red transfers send the black gram,
+ *        so the controller red ram still holds the previous image for a differential refresh
+ */
+#ifndef SSD1681_MONOCHROME
+    #define SSD1681_MONOCHROME               0         /**< 1 builds a black and white only driver */
+#endif
+
+/**
+ * @brief ssd1681 spi read chunk size definition
+ */
+#ifndef SSD1681_SPI_READ_CHUNK_SIZE
+    #define SSD1681_SPI_READ_CHUNK_SIZE      4096      /**< 4096 bytes */
+#endif
+
+/**
+ * @brief ssd1681 spi write chunk size definition
+ */
+#ifndef SSD1681_SPI_WRITE_CHUNK_SIZE
+    #define SSD1681_SPI_WRITE_CHUNK_SIZE     4096      /**< 4096 bytes */
+#endif
+
+/**
+ * @brief ssd1681 verify chunk size definition
+ */
+#ifndef SSD1681_VERIFY_CHUNK_SIZE
+    #define SSD1681_VERIFY_CHUNK_SIZE        64        /**< 64 bytes */
+#endif
+
 /**
  * @brief ssd1681 busy max delay definition
  */
@@ -70,6 +129,34 @@ extern "C"{
     #define SSD1681_BUSY_MAX_RETRY_TIMES     2000      /**< 2000 times */
 #endif
 
+/**
+ * @brief ssd1681 busy fine poll delay definition
+ */
+#ifndef SSD1681_BUSY_FINE_DELAY_MS
+    #define SSD1681_BUSY_FINE_DELAY_MS       1         /**< 1ms */
+#endif
+
+/**
+ * @brief ssd1681 busy prediction table size definition
+ */
+#ifndef SSD1681_BUSY_PREDICT_NUM
+    #define SSD1681_BUSY_PREDICT_NUM         8         /**< 8 operations */
+#endif
+
+/**
+ * @brief ssd1681 busy prediction guard time definition
+ */
+#ifndef SSD1681_BUSY_PREDICT_GUARD_MS
+    #define SSD1681_BUSY_PREDICT_GUARD_MS    20        /**< wake up 20ms before the predicted end */
+#endif
+
+/**
+ * @brief ssd1681 busy prediction temperature band definition
+ */
+#ifndef SSD1681_BUSY_PREDICT_TEMP_STEP
+    #define SSD1681_BUSY_PREDICT_TEMP_STEP   10        /**< 10C */
+#endif
+
 /**
  * @brief ssd1681 bool enumeration definition
  */
@@ -358,6 +445,15 @@ typedef enum
     SSD1681_DISPLAY_CONTROL_INVERSE = 0x08,        /**< inverse ram content */
 } ssd1681_display_control_t;
 
+/**
+ * @brief ssd1681 page enumeration definition
+ */
+typedef enum  
+{
+    SSD1681_PAGE_BLACK = 0x00,        /**< page in the black ram */
+    SSD1681_PAGE_RED   = 0x01,        /**< page in the red ram */
+} ssd1681_page_t;
+
 /**
  * @brief ssd1681 display sequence enumeration definition
  */
@@ -527,6 +623,64 @@ typedef enum
     SSD1681_FONT_24 = 0x18,        /**< font 24 */
 } ssd1681_font_t;
 
+/**
+ * @brief ssd1681 interface enumeration definition
+ */
+typedef enum  
+{
+    SSD1681_INTERFACE_4_WIRE = 0x00,        /**< 4-wire spi with a command/data gpio */
+    SSD1681_INTERFACE_3_WIRE = 0x01,        /**< 3-wire spi with the command/data bit in the 9-bit frame */
+} ssd1681_interface_t;
+
+/**
+ * @brief ssd1681 busy wait mode enumeration definition
+ */
+typedef enum  
+{
+    SSD1681_BUSY_MODE_POLL = 0x00,        /**< poll the busy gpio with delay_ms */
+    SSD1681_BUSY_MODE_IRQ  = 0x01,        /**< sleep in busy_gpio_wait until the busy falling edge */
+} ssd1681_busy_mode_t;
+
+/**
+ * @brief ssd1681 waveform enumeration definition
+ */
+typedef enum  
+{
+    SSD1681_WAVEFORM_FULL    = 0x00,        /**< full quality waveform */
+    SSD1681_WAVEFORM_FAST    = 0x01,        /**< fast full waveform */
+    SSD1681_WAVEFORM_PARTIAL = 0x02,        /**< partial waveform */
+} ssd1681_waveform_t;
+
+/**
+ * @brief ssd1681 busy prediction structure definition
+ */
+typedef struct ssd1681_busy_predict_s
+{
+    uint32_t key;          /**< command, display sequence, lut and temperature band */
+    uint16_t ms;           /**< predicted busy time */
+    uint8_t valid;         /**< valid flag */
+} ssd1681_busy_predict_t;
+
+/**
+ * @brief ssd1681 init record structure definition
+ */
+typedef struct ssd1681_init_record_s
+{
+    uint8_t command;                                  /**< command */
+    uint8_t len;                                      /**< data length */
+    uint8_t data[SSD1681_INIT_RECORD_MAX_LEN];        /**< data */
+} ssd1681_init_record_t;
+
+/**
+ * @brief ssd1681 lut band structure definition
+ */
+typedef struct ssd1681_lut_band_s
+{
+    int16_t temperature_min;        /**< lowest temperature of the band in C */
+    const uint8_t *lut;             /**< point to the lut register data */
+    uint16_t len;                   /**< lut register length */
+} ssd1681_lut_band_t;
+
 /**
  * @brief ssd1681 handle structure definition
  */
@@ -545,11 +699,57 @@ typedef struct ssd1681_handle_s
     uint8_t (*busy_gpio_init)(void);                             /**< point to a busy_gpio_init function address */
     uint8_t (*busy_gpio_deinit)(void);                           /**< point to a busy_gpio_deinit function address */
     uint8_t (*busy_gpio_read)(uint8_t *value);                   /**< point to a busy_gpio_read function address */
+    uint8_t (*busy_gpio_wait)(uint32_t timeout_ms);              /**< point to a busy_gpio_wait function address */
     void (*debug_print)(const char *const fmt, ...);             /**< point to a debug_print function address */
     void (*delay_ms)(uint32_t ms);                               /**< point to a delay_ms function address */
+    uint8_t (*spi_write_cmd_dma)(uint8_t *buf, uint16_t len);    /**< point to a spi_write_cmd_dma function address */
+    void (*dma_callback)(uint8_t color, uint8_t res);            /**< point to a dma_callback function address */
     uint8_t inited;                                              /**< inited flag */
-    uint8_t black_gram[200][25];                                 /**< black gram buffer */
-    uint8_t red_gram[200][25];                                   /**< red gram buffer */
+    uint8_t interface;                                           /**< interface type */
+    uint8_t busy_mode;                                           /**< busy wait mode */
+    uint8_t busy_cmd;                                            /**< last command */
+    uint8_t busy_sequence;                                       /**< last display sequence */
+    uint8_t busy_lut;                                            /**< last lut checksum */
+    int8_t busy_temperature;                                     /**< last temperature band */
+    uint8_t busy_predict_next;                                   /**< next replaced prediction */
+    ssd1681_busy_predict_t busy_predict[SSD1681_BUSY_PREDICT_NUM];  /**< busy prediction table */
+    volatile uint8_t dma_busy;                                   /**< dma busy flag */
+    uint8_t dma_color;                                           /**< dma color */
+    uint8_t staged;                                              /**< staged planes */
+    uint8_t ram_clear;                                           /**< planes known to be clear in the controller ram */
+    uint8_t ram_hash_valid;                                      /**< planes with a known ram hash */
+    uint32_t ram_hash[2];                                        /**< controller ram hash */
+    uint8_t force;                                               /**< force update flag */
+    uint8_t *diff_gram[2];                                       /**< last uploaded frame buffers */
+    uint8_t diff_valid;                                          /**< planes with a known last frame */
+    uint8_t burst;                                               /**< burst refresh flag */
+    const ssd1681_lut_band_t *lut_table;                         /**< lut band table */
+    uint8_t lut_table_num;                                       /**< lut band number */
+    const uint8_t *lut;                                          /**< loaded lut */
+    uint8_t lut_loaded;                                          /**< the lut register holds a written lut */
+    uint8_t shadow[24];                                          /**< shadow registers */
+    uint16_t shadow_valid;                                       /**< shadow valid flags */
+    uint16_t shadow_saved;                                       /**< shadow saved flags */
+    const uint8_t *lut_saved;                                    /**< lut to resume */
+    uint16_t lut_saved_len;                                      /**< lut to resume length */
+    uint8_t sleeping;                                            /**< deep sleep flag */
+    uint8_t power_enable;                                        /**< power manager enable */
+    uint8_t power_mode;                                          /**< power manager deep sleep mode */
+    uint32_t power_idle_time;                                    /**< power manager idle time */
+    uint32_t power_idle;                                         /**< current idle time */
+    uint32_t power_awake_ms;                                     /**< awake time */
+    uint32_t power_sleep_ms;                                     /**< sleep time */
+    uint32_t power_wake_count;                                   /**< wake count */
+    uint8_t (*black_gram)[25];                                   /**< black gram buffer */
+#if (SSD1681_MONOCHROME == 0)
+    uint8_t (*red_gram)[25];                                     /**< red gram buffer */
+#endif
+#if (SSD1681_EMBEDDED_GRAM != 0)
+    uint8_t black_gram_buf[200][25];                             /**< embedded black gram buffer */
+#if (SSD1681_MONOCHROME == 0)
+    uint8_t red_gram_buf[200][25];                               /**< embedded red gram buffer */
+#endif
+#endif
 } ssd1681_handle_t;
 
 /**
@@ -691,6 +891,14 @@ typedef struct ssd1681_info_s
  */
 #define DRIVER_SSD1681_LINK_BUSY_GPIO_READ(HANDLE, FUC)                (HANDLE)->busy_gpio_read = FUC
 
+/**
+ * @brief     link busy_gpio_wait function
+ * @param[in] HANDLE pointer to an ssd1681 handle structure
+ * @param[in] FUC pointer to a busy_gpio_wait function address
+ * @note      it is optional and only used in the irq busy mode
+ */
+#define DRIVER_SSD1681_LINK_BUSY_GPIO_WAIT(HANDLE, FUC)                (HANDLE)->busy_gpio_wait = FUC
+
 /**
  * @brief     link delay_ms function
  * @param[in] HANDLE pointer to an ssd1681 handle structure
@@ -707,6 +915,39 @@ typedef struct ssd1681_info_s
  */
 #define DRIVER_SSD1681_LINK_DEBUG_PRINT(HANDLE, FUC)                   (HANDLE)->debug_print = FUC
 
+/**
+ * @brief     link spi_write_cmd_dma function
+ * @param[in] HANDLE pointer to an ssd1681 handle structure
+ * @param[in] FUC pointer to a spi_write_cmd_dma function address
+ * @note      it is optional and only used by ssd1681_gram_update_dma
+ */
+#define DRIVER_SSD1681_LINK_SPI_WRITE_CMD_DMA(HANDLE, FUC)             (HANDLE)->spi_write_cmd_dma = FUC
+
+/**
+ * @brief     link dma_callback function
+ * @param[in] HANDLE pointer to an ssd1681 handle structure
+ * @param[in] FUC pointer to a dma_callback function address
+ * @note      it is optional and called by ssd1681_dma_irq_handler
+ */
+#define DRIVER_SSD1681_LINK_DMA_CALLBACK(HANDLE, FUC)                  (HANDLE)->dma_callback = FUC
+
+/**
+ * @brief     link the gram buffers
+ * @param[in] HANDLE pointer to an ssd1681 handle structure
+ * @param[in] BLACK pointer to a 5000 bytes black gram buffer
+ * @param[in] RED pointer to a 5000 bytes red gram buffer
+ * @note      it is optional when SSD1681_EMBEDDED_GRAM is 1 and the embedded buffers are used if not linked,
+ *            the buffers can be placed in any memory region and shared between handles,
+ *            RED is ignored when SSD1681_MONOCHROME is 1
+ */
+#if (SSD1681_MONOCHROME != 0)
+#define DRIVER_SSD1681_LINK_GRAM(HANDLE, BLACK, RED)                    ((HANDLE)->black_gram = (uint8_t (*)[25])(BLACK), \
+                                                                         (void)(RED))
+#else
+#define DRIVER_SSD1681_LINK_GRAM(HANDLE, BLACK, RED)                    ((HANDLE)->black_gram = (uint8_t (*)[25])(BLACK), \
+                                                                         (HANDLE)->red_gram = (uint8_t (*)[25])(RED))
+#endif
+
 /**
  * @}
  */
@@ -728,6 +969,64 @@ typedef struct ssd1681_info_s
  */
 uint8_t ssd1681_info(ssd1681_info_t *info);
 
+/**
+ * @brief     set the chip interface
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] interface chip interface
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      it must be called before ssd1681_init
+ *            in the 3-wire mode the command/data gpio is not used and its link functions can be NULL
+ */
+uint8_t ssd1681_set_interface(ssd1681_handle_t *handle, ssd1681_interface_t interface);
+
+/**
+ * @brief      get the chip interface
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *interface pointer to a chip interface buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ssd1681_get_interface(ssd1681_handle_t *handle, ssd1681_interface_t *interface);
+
+/**
+ * @brief     set the busy wait mode
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] mode busy wait mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 busy_gpio_wait is NULL
+ * @note      the irq mode needs the busy_gpio_wait link function
+ */
+uint8_t ssd1681_set_busy_mode(ssd1681_handle_t *handle, ssd1681_busy_mode_t mode);
+
+/**
+ * @brief      get the busy wait mode
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *mode pointer to a busy wait mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ssd1681_get_busy_mode(ssd1681_handle_t *handle, ssd1681_busy_mode_t *mode);
+
+/**
+ * @brief      get the predicted busy time of the last operation
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *ms pointer to a predicted time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       ms is 0 if the operation has not been measured yet,
+ *             an operation is keyed by the command, the display sequence, the lut and the temperature band
+ */
+uint8_t ssd1681_get_busy_prediction(ssd1681_handle_t *handle, uint32_t *ms);
+
 /**
  * @brief     initialize the chip
  * @param[in] *handle pointer to an ssd1681 handle structure
@@ -738,10 +1037,25 @@ uint8_t ssd1681_info(ssd1681_info_t *info);
  *            - 3 linked functions is NULL
  *            - 4 reset failed
  *            - 5 gpio init failed
- * @note      none
+ * @note      the reset waits on the busy pin instead of a fixed delay
  */
 uint8_t ssd1681_init(ssd1681_handle_t *handle);
 
+/**
+ * @brief     attach to a running chip without the reset
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 busy wait failed
+ *            - 5 gpio init failed
+ * @note      the chip keeps its registers, lut and ram, it must not be in the deep sleep,
+ *            use ssd1681_gram_read_back or ssd1681_gram_restore to get the gram back
+ */
+uint8_t ssd1681_attach(ssd1681_handle_t *handle);
+
 /**
  * @brief     close the chip
  * @param[in] *handle pointer to an ssd1681 handle structure
@@ -767,7 +1081,9 @@ uint8_t ssd1681_deinit(ssd1681_handle_t *handle);
  *            - 1 clear failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the upload is skipped when the controller ram is known to be clear and the force update is disabled,
+ *            so is the refresh if nothing is staged, the ram is cleared by the chip auto write when the ram layout
+ *            is the default one
  */
 uint8_t ssd1681_clear(ssd1681_handle_t *handle, ssd1681_color_t color);
 
@@ -780,10 +1096,268 @@ uint8_t ssd1681_clear(ssd1681_handle_t *handle, ssd1681_color_t color);
  *            - 1 gram update failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      it is the same as ssd1681_gram_upload followed by ssd1681_gram_activate,
+ *            when the gram matches the controller ram the transfer is skipped and so is the refresh if nothing is staged,
+ *            unless the force update is enabled
  */
 uint8_t ssd1681_gram_update(ssd1681_handle_t *handle, ssd1681_color_t color);
 
+/**
+ * @brief     upload the gram data to the controller ram without refreshing the display
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram upload failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the plane stays staged until ssd1681_gram_activate is called,
+ *            the transfer is skipped when the gram matches the controller ram and the force update is disabled
+ */
+uint8_t ssd1681_gram_upload(ssd1681_handle_t *handle, ssd1681_color_t color);
+
+/**
+ * @brief     fill the controller ram and the gram with a regular pattern
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @param[in] height step height
+ * @param[in] width step width
+ * @param[in] first first step value
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram fill pattern failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 first is over 1 or the step is invalid
+ *            - 5 ram layout is not the default one
+ * @note      the chip writes a checkerboard of height x width steps starting at ram x 0 and y 0,
+ *            a 200 step height gives vertical stripes, a 200 step width gives horizontal stripes
+ *            and both give a solid fill, the plane is staged like after ssd1681_gram_upload
+ */
+uint8_t ssd1681_gram_fill_pattern(ssd1681_handle_t *handle, ssd1681_color_t color,
+                                  ssd1681_step_height_t height, ssd1681_step_width_t width, uint8_t first);
+
+/**
+ * @brief     update the gram data with the dma
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram update failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 dma is busy
+ *            - 5 spi_write_cmd_dma is NULL
+ *            - 6 interface is not 4-wire
+ * @note      it returns after the transfer is started and the gram must not be changed until the dma is done,
+ *            ssd1681_dma_irq_handler must be called in the dma irq and other driver calls fail before that,
+ *            the display is not refreshed, call ssd1681_gram_activate after the dma is done,
+ *            the transfer is never skipped so the dma irq always comes
+ */
+uint8_t ssd1681_gram_update_dma(ssd1681_handle_t *handle, ssd1681_color_t color);
+
+/**
+ * @brief     dma irq handler
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] res transfer result
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1681_dma_irq_handler(ssd1681_handle_t *handle, uint8_t res);
+
+/**
+ * @brief     refresh the display with the staged controller ram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram activate failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the busy wait is done by the upload, so the refresh starts right after the call,
+ *            all staged planes are cleared
+ */
+uint8_t ssd1681_gram_activate(ssd1681_handle_t *handle);
+
+/**
+ * @brief     show a page preloaded in the controller ram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] page ram page
+ * @param[in] invert bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 page flip failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      load the pages once with ssd1681_gram_upload of both colors, then a flip only changes the
+ *            display update control ram options and refreshes, nothing is sent to the ram,
+ *            the black page bypasses the red ram, the red page bypasses the black ram and shows the inverse
+ *            red ram so red gram bits set are dark like the black gram bits cleared,
+ *            the black page only uses the lut groups LUT0 (black) and LUT1 (white) and works with any lut,
+ *            the red page reads the black ram as 0 so its pixels use LUT0 (red 0) and LUT2 (red 1),
+ *            it needs a lut that drives LUT2 to white, the otp lut of a red panel drives LUT2 to red
+ *            and the red page is then shown black and red, so it is meant for black and white panels
+ *            with a custom lut loaded by ssd1681_set_lut_register, ssd1681_select_lut or ssd1681_use_waveform,
+ *            call ssd1681_set_display_update_control with the normal options to leave the page mode
+ */
+uint8_t ssd1681_page_flip(ssd1681_handle_t *handle, ssd1681_page_t page, ssd1681_bool_t invert);
+
+/**
+ * @brief      get the staged status of a plane
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[in]  color color type
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       a plane is staged after it is uploaded and before the next activation
+ */
+uint8_t ssd1681_gram_get_staged(ssd1681_handle_t *handle, ssd1681_color_t color, ssd1681_bool_t *enable);
+
+/**
+ * @brief      read a region of the controller ram in bulk
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[in]  color color type
+ * @param[in]  x_start start x byte address
+ * @param[in]  x_end end x byte address
+ * @param[in]  y_start start y address
+ * @param[in]  y_end end y address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read ram region failed
+ *             - 2 handle or buf is NULL
+ *             - 3 handle is not initialized
+ *             - 4 region is invalid
+ * @note       x_start, x_end <= 0x18 and y_start, y_end <= 0xC7,
+ *             the bytes are stored in the address order of the data entry mode,
+ *             the ram window is set back to the previous one after the read
+ */
+uint8_t ssd1681_read_ram_region(ssd1681_handle_t *handle, ssd1681_color_t color,
+                                uint8_t x_start, uint8_t x_end, uint16_t y_start, uint16_t y_end,
+                                uint8_t *buf, uint32_t len);
+
+/**
+ * @brief     read the controller ram back into the gram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram read back failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 red gram is not built
+ * @note      the data entry mode must be the one used by the upload,
+ *            red is rejected in the monochrome build because it has no red gram
+ */
+uint8_t ssd1681_gram_read_back(ssd1681_handle_t *handle, ssd1681_color_t color);
+
+/**
+ * @brief      verify the controller ram against the gram
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[in]  color color type
+ * @param[out] *match pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 gram verify failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the ram is read in small chunks and compared with the gram, the read stops at the first difference,
+ *             the data entry mode must be the one used by the upload
+ */
+uint8_t ssd1681_gram_verify(ssd1681_handle_t *handle, ssd1681_color_t color, ssd1681_bool_t *match);
+
+/**
+ * @brief     restore the gram from a snapshot of the controller ram
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @param[in] *buf pointer to a snapshot buffer
+ * @param[in] len snapshot length
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram restore failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 snapshot is invalid
+ *            - 5 red gram is not built
+ * @note      the snapshot must be a copy of the gram taken after its last upload,
+ *            nothing is sent to the chip, red is rejected in the monochrome build
+ */
+uint8_t ssd1681_gram_restore(ssd1681_handle_t *handle, ssd1681_color_t color, const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     enable or disable the burst refresh mode
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set burst failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      enabling powers up the clock and analog circuits and loads the temperature and the lut once,
+ *            then every activation only runs the display step until the burst is disabled,
+ *            disabling runs the power down step of the full sequence
+ */
+uint8_t ssd1681_set_burst(ssd1681_handle_t *handle, ssd1681_bool_t enable);
+
+/**
+ * @brief      get the burst refresh mode
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ssd1681_get_burst(ssd1681_handle_t *handle, ssd1681_bool_t *enable);
+
+/**
+ * @brief     enable or disable the force update
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      by default an update whose gram matches the controller ram skips the transfer and the refresh,
+ *            enabling the force update always sends and refreshes
+ */
+uint8_t ssd1681_set_force_update(ssd1681_handle_t *handle, ssd1681_bool_t enable);
+
+/**
+ * @brief      get the force update status
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ssd1681_get_force_update(ssd1681_handle_t *handle, ssd1681_bool_t *enable);
+
+/**
+ * @brief     set the last frame buffer of a plane
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] color color type
+ * @param[in] *buf pointer to a 5000 bytes buffer, NULL disables it
+ * @param[in] len buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 len is invalid
+ *            - 5 color is invalid
+ * @note      the driver keeps a copy of the last uploaded frame in the buffer and the next upload
+ *            only sends the rows that changed, the first upload after setting it is a full one
+ */
+uint8_t ssd1681_set_diff_buffer(ssd1681_handle_t *handle, ssd1681_color_t color, uint8_t *buf, uint16_t len);
+
 /**
  * @brief     clear the screen in the gram
  * @param[in] *handle pointer to an ssd1681 handle structure
@@ -1093,6 +1667,147 @@ uint8_t ssd1681_set_booster_soft_start(ssd1681_handle_t *handle,
  */
 uint8_t ssd1681_set_mode(ssd1681_handle_t *handle, ssd1681_mode_t mode);
 
+/**
+ * @brief     wake up from the deep sleep and restore the configuration
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 resume failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 reset failed
+ * @note      the last written configuration registers and the last lut loaded by
+ *            ssd1681_select_lut or ssd1681_use_waveform are written again,
+ *            a lut written by ssd1681_set_lut_register is not restored,
+ *            the display update control 2 is not replayed so that a stale otp load can not drop the lut
+ */
+uint8_t ssd1681_resume(ssd1681_handle_t *handle);
+
+/**
+ * @brief     run an init table
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] *table pointer to an init record table
+ * @param[in] num record number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run init table failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 table is invalid
+ * @note      the busy pin is checked once before the table and again only after
+ *            a record that starts an internal operation such as the software reset
+ */
+uint8_t ssd1681_run_init_table(ssd1681_handle_t *handle, const ssd1681_init_record_t *table, uint16_t num);
+
+/**
+ * @brief     enable or disable the power manager
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set power manager failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when enabled, every driver function that accesses the bus wakes the chip from the deep sleep first,
+ *            the raw ssd1681_write_cmd, ssd1681_write_data and ssd1681_read_data do not wake it
+ */
+uint8_t ssd1681_set_power_manager(ssd1681_handle_t *handle, ssd1681_bool_t enable);
+
+/**
+ * @brief      get the power manager status
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get power manager failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ssd1681_get_power_manager(ssd1681_handle_t *handle, ssd1681_bool_t *enable);
+
+/**
+ * @brief     set the idle time before the deep sleep
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] ms idle time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 set power idle time failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the idle time starts after the last upload or activation
+ */
+uint8_t ssd1681_set_power_idle_time(ssd1681_handle_t *handle, uint32_t ms);
+
+/**
+ * @brief      get the idle time before the deep sleep
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *ms pointer to an idle time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get power idle time failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ssd1681_get_power_idle_time(ssd1681_handle_t *handle, uint32_t *ms);
+
+/**
+ * @brief     set the deep sleep mode used by the power manager
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] mode deep sleep mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set power sleep mode failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 mode is invalid
+ * @note      the ram is lost in the deep sleep mode 2 and the gram must be uploaded again
+ */
+uint8_t ssd1681_set_power_sleep_mode(ssd1681_handle_t *handle, ssd1681_mode_t mode);
+
+/**
+ * @brief      get the deep sleep mode used by the power manager
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *mode pointer to a deep sleep mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get power sleep mode failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ssd1681_get_power_sleep_mode(ssd1681_handle_t *handle, ssd1681_mode_t *mode);
+
+/**
+ * @brief     run the power manager
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] ms time passed since the last call in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 power process failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it periodically, the chip enters the deep sleep once the idle time
+ *            has passed and the busy pin is low, the time is also added to the statistics
+ */
+uint8_t ssd1681_power_process(ssd1681_handle_t *handle, uint32_t ms);
+
+/**
+ * @brief      get the power manager statistics
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *awake_ms pointer to an awake time buffer
+ * @param[out] *sleep_ms pointer to a sleep time buffer
+ * @param[out] *wake_count pointer to a wake count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get power statistics failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the time is the sum passed to ssd1681_power_process
+ */
+uint8_t ssd1681_get_power_statistics(ssd1681_handle_t *handle, uint32_t *awake_ms, uint32_t *sleep_ms, uint32_t *wake_count);
+
 /**
  * @brief     set the data entry mode
  * @param[in] *handle pointer to an ssd1681 handle structure
@@ -1368,6 +2083,81 @@ uint8_t ssd1681_get_status(ssd1681_handle_t *handle, uint8_t *status);
  */
 uint8_t ssd1681_set_lut_register(ssd1681_handle_t *handle, uint8_t *reg, uint16_t len);
 
+/**
+ * @brief     set the temperature indexed lut table
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] *table pointer to a lut band table
+ * @param[in] num band number
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 table is invalid
+ * @note      the bands must be sorted by the ascending temperature_min and the table must stay valid,
+ *            no lut is loaded until ssd1681_select_lut or ssd1681_select_lut_by_sensor is called
+ */
+uint8_t ssd1681_set_lut_table(ssd1681_handle_t *handle, const ssd1681_lut_band_t *table, uint8_t num);
+
+/**
+ * @brief     load the lut of the temperature band
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] temperature temperature in C
+ * @return    status code
+ *            - 0 success
+ *            - 1 select lut failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 lut table is not set
+ * @note      the band with the highest temperature_min not above the temperature is used,
+ *            a temperature below all bands uses the first band,
+ *            the lut is not written again if it is already loaded,
+ *            the refresh keeps the band instead of loading the otp lut
+ */
+uint8_t ssd1681_select_lut(ssd1681_handle_t *handle, int16_t temperature);
+
+/**
+ * @brief      sense the temperature and load the lut of its band
+ * @param[in]  *handle pointer to an ssd1681 handle structure
+ * @param[out] *temperature pointer to a temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 select lut by sensor failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 lut table is not set
+ * @note       the temperature sensor selected by ssd1681_set_temperature_sensor is used,
+ *             only the temperature is sensed and the loaded band is not replaced by the otp lut
+ */
+uint8_t ssd1681_select_lut_by_sensor(ssd1681_handle_t *handle, int16_t *temperature);
+
+/**
+ * @brief      get a built-in waveform
+ * @param[in]  waveform waveform type
+ * @param[out] **lut pointer to a lut pointer buffer
+ * @param[out] *len pointer to a lut length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 waveform is invalid
+ * @note       the lut can be used in a ssd1681_lut_band_t table
+ */
+uint8_t ssd1681_get_waveform(ssd1681_waveform_t waveform, const uint8_t **lut, uint16_t *len);
+
+/**
+ * @brief     load a built-in waveform
+ * @param[in] *handle pointer to an ssd1681 handle structure
+ * @param[in] waveform waveform type
+ * @return    status code
+ *            - 0 success
+ *            - 1 use waveform failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 waveform is invalid
+ * @note      the lut is not written again if it is already loaded,
+ *            it is kept by the refresh and written again by ssd1681_resume
+ */
+uint8_t ssd1681_use_waveform(ssd1681_handle_t *handle, ssd1681_waveform_t waveform);
+
 /**
  * @brief     set the crc calculation
  * @param[in] *handle pointer to an ssd1681 handle structure
@@ -1376,7 +2166,7 @@ uint8_t ssd1681_set_lut_register(ssd1681_handle_t *handle, uint8_t *reg, uint16_
  *            - 1 set crc calculation failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the crc covers the otp content, not the display ram
  */
 uint8_t ssd1681_set_crc_calculation(ssd1681_handle_t *handle);
 
@@ -1389,7 +2179,7 @@ uint8_t ssd1681_set_crc_calculation(ssd1681_handle_t *handle);
  *             - 1 get crc status failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       the crc covers the otp content, not the display ram
  */
 uint8_t ssd1681_get_crc_status(ssd1681_handle_t *handle, uint16_t *status);
 
@@ -1568,7 +2358,9 @@ uint8_t ssd1681_nop(ssd1681_handle_t *handle);
  *            - 1 write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the shadow registers, the loaded lut and the ram state are dropped,
+ *            a reset, deep sleep, activation or lut write command also updates the staged planes,
+ *            the sleep flag and the lut kept by the refresh and the resume
  */
 uint8_t ssd1681_write_cmd(ssd1681_handle_t *handle, uint8_t *buf, uint8_t len);
 
@@ -38,26 +38,6 @@
 #include <stdlib.h>
 
 static ssd1681_handle_t gs_handle;        /**< ssd1681 handle */
-static uint8_t gs_lut[153] = {            /**< lut */
-    0x80, 0x48, 0x40, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x40, 0x48, 0x80, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x80, 0x48, 0x40, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x40, 0x48, 0x80, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0xA, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x8, 0x1, 0x0, 0x8, 0x1, 0x0, 0x2,
-    0xA, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x0, 0x0, 0x0,
-};
 static uint8_t gs_image[40000] =          /**< test image */
 {
     0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
@@ -2772,11 +2752,11 @@ uint8_t ssd1681_display_test(void)
         return 1;
     }
 
-    /* set the lut register */
-    res = ssd1681_set_lut_register(&gs_handle, gs_lut, 153);
+    /* use the full waveform */
+    res = ssd1681_use_waveform(&gs_handle, SSD1681_WAVEFORM_FULL);
     if (res != 0)
     {
-        ssd1681_interface_debug_print("ssd1681: set lut register failed.\n");
+        ssd1681_interface_debug_print("ssd1681: use waveform failed.\n");
         (void)ssd1681_deinit(&gs_handle);
 
         return 1;
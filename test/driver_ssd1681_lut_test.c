@@ -0,0 +1,551 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ssd1681_lut_test.c
+ * @brief     driver ssd1681 lut test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-08-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/08/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ssd1681_lut_test.h"
+
+static ssd1681_handle_t gs_handle;        /**< ssd1681 handle */
+static uint8_t gs_dc;                     /**< last command or data level */
+static uint8_t gs_command;                /**< last command */
+static uint8_t gs_sequence;               /**< last display sequence */
+static uint32_t gs_lut_count;             /**< lut upload count */
+
+/**
+ * @brief     spi cmd data gpio write with the level tracked
+ * @param[in] value written value
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio write failed
+ * @note      none
+ */
+static uint8_t a_ssd1681_lut_test_cmd_data_gpio_write(uint8_t value)
+{
+    gs_dc = value;
+    
+    return ssd1681_interface_spi_cmd_data_gpio_write(value);
+}
+
+/**
+ * @brief     spi write with the lut uploads counted
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ssd1681_lut_test_spi_write_cmd(uint8_t *buf, uint16_t len)
+{
+    if ((gs_dc == 0) && (len != 0))
+    {
+        gs_command = buf[len - 1];
+        if (buf[0] == 0x32)
+        {
+            gs_lut_count++;
+        }
+    }
+    else if ((gs_command == 0x22) && (len != 0))
+    {
+        gs_sequence = buf[0];
+    }
+    
+    return ssd1681_interface_spi_write_cmd(buf, len);
+}
+
+/**
+ * @brief  lut test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the lut uploads are counted on the spi bus
+ */
+uint8_t ssd1681_lut_test(void)
+{
+    uint8_t res;
+    const uint8_t *full;
+    const uint8_t *fast;
+    uint16_t full_len;
+    uint16_t fast_len;
+    ssd1681_lut_band_t table[2];
+    ssd1681_info_t info;
+
+    /* link functions */
+    DRIVER_SSD1681_LINK_INIT(&gs_handle, ssd1681_handle_t);
+    DRIVER_SSD1681_LINK_SPI_INIT(&gs_handle, ssd1681_interface_spi_init);
+    DRIVER_SSD1681_LINK_SPI_DEINIT(&gs_handle, ssd1681_interface_spi_deinit);
+    DRIVER_SSD1681_LINK_SPI_WRITE_CMD(&gs_handle, a_ssd1681_lut_test_spi_write_cmd);
+    DRIVER_SSD1681_LINK_SPI_READ_CMD(&gs_handle, ssd1681_interface_spi_read_cmd);
+    DRIVER_SSD1681_LINK_SPI_CMD_DATA_GPIO_INIT(&gs_handle, ssd1681_interface_spi_cmd_data_gpio_init);
+    DRIVER_SSD1681_LINK_SPI_CMD_DATA_GPIO_DEINIT(&gs_handle, ssd1681_interface_spi_cmd_data_gpio_deinit);
+    DRIVER_SSD1681_LINK_SPI_CMD_DATA_GPIO_WRITE(&gs_handle, a_ssd1681_lut_test_cmd_data_gpio_write);
+    DRIVER_SSD1681_LINK_RESET_GPIO_INIT(&gs_handle, ssd1681_interface_reset_gpio_init);
+    DRIVER_SSD1681_LINK_RESET_GPIO_DEINIT(&gs_handle, ssd1681_interface_reset_gpio_deinit);
+    DRIVER_SSD1681_LINK_RESET_GPIO_WRITE(&gs_handle, ssd1681_interface_reset_gpio_write);
+    DRIVER_SSD1681_LINK_BUSY_GPIO_INIT(&gs_handle, ssd1681_interface_busy_gpio_init);
+    DRIVER_SSD1681_LINK_BUSY_GPIO_DEINIT(&gs_handle, ssd1681_interface_busy_gpio_deinit);
+    DRIVER_SSD1681_LINK_BUSY_GPIO_READ(&gs_handle, ssd1681_interface_busy_gpio_read);
+    DRIVER_SSD1681_LINK_DELAY_MS(&gs_handle, ssd1681_interface_delay_ms);
+    DRIVER_SSD1681_LINK_DEBUG_PRINT(&gs_handle, ssd1681_interface_debug_print);
+
+    /* ssd1681 info */
+    res = ssd1681_info(&info);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: get info failed.\n");
+
+        return 1;
+    }
+    else
+    {
+        /* print chip information */
+        ssd1681_interface_debug_print("ssd1681: chip is %s.\n", info.chip_name);
+        ssd1681_interface_debug_print("ssd1681: manufacturer is %s.\n", info.manufacturer_name);
+        ssd1681_interface_debug_print("ssd1681: interface is %s.\n", info.interface);
+        ssd1681_interface_debug_print("ssd1681: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        ssd1681_interface_debug_print("ssd1681: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        ssd1681_interface_debug_print("ssd1681: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        ssd1681_interface_debug_print("ssd1681: max current is %0.2fmA.\n", info.max_current_ma);
+        ssd1681_interface_debug_print("ssd1681: max temperature is %0.1fC.\n", info.temperature_max);
+        ssd1681_interface_debug_print("ssd1681: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+
+    /* start lut test */
+    ssd1681_interface_debug_print("ssd1681: start lut test.\n");
+
+    /* the command bytes are only seen on the 4-wire bus */
+    res = ssd1681_set_interface(&gs_handle, SSD1681_INTERFACE_4_WIRE);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: set interface failed.\n");
+
+        return 1;
+    }
+
+    /* init */
+    res = ssd1681_init(&gs_handle);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: init failed.\n");
+
+        return 1;
+    }
+
+    /* reset the chip */
+    res = ssd1681_software_reset(&gs_handle);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: software reset failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set the driver output */
+    res = ssd1681_set_driver_output(&gs_handle, 0xC7, SSD1681_BOOL_FALSE, SSD1681_BOOL_FALSE, SSD1681_BOOL_FALSE);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: set the driver output failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set the data entry mode */
+    res = ssd1681_set_data_entry_mode(&gs_handle, SSD1681_ADDRESS_MODE_Y_DECREMENT_X_INCREMENT, SSD1681_ADDRESS_DIRECTION_UPDATED_X);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: set data entry mode failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set the internal sensor */
+    res = ssd1681_set_temperature_sensor(&gs_handle, SSD1681_TEMPERATURE_SENSOR_INTERNAL);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: set temperature sensor failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set the x range */
+    res = ssd1681_set_ram_x(&gs_handle, 0x00, 0x18);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: set ram x failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set the y range */
+    res = ssd1681_set_ram_y(&gs_handle, 0xC7, 0x00);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: set ram y failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set the ram x address counter */
+    res = ssd1681_set_ram_x_address_counter(&gs_handle, 0x00);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: set ram x address counter failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set the ram y address counter */
+    res = ssd1681_set_ram_y_address_counter(&gs_handle, 0xC7);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: set ram y address counter failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* force the refresh */
+    res = ssd1681_set_force_update(&gs_handle, SSD1681_BOOL_TRUE);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: set force update failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* get the full waveform */
+    res = ssd1681_get_waveform(SSD1681_WAVEFORM_FULL, &full, &full_len);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: get waveform failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* get the fast waveform */
+    res = ssd1681_get_waveform(SSD1681_WAVEFORM_FAST, &fast, &fast_len);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: get waveform failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* waveform test */
+    ssd1681_interface_debug_print("ssd1681: waveform test.\n");
+
+    gs_lut_count = 0;
+
+    /* load the full waveform */
+    res = ssd1681_use_waveform(&gs_handle, SSD1681_WAVEFORM_FULL);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: use waveform failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* check the upload */
+    if (gs_lut_count != 1)
+    {
+        ssd1681_interface_debug_print("ssd1681: lut is not uploaded.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* clear the gram */
+    res = ssd1681_gram_clear(&gs_handle, SSD1681_COLOR_BLACK);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: gram clear failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* draw a rect */
+    res = ssd1681_gram_fill_rect(&gs_handle, SSD1681_COLOR_BLACK, 20, 20, 60, 60, 1);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: gram fill rect failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* update */
+    res = ssd1681_gram_update(&gs_handle, SSD1681_COLOR_BLACK);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: gram update failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* draw a rect */
+    res = ssd1681_gram_fill_rect(&gs_handle, SSD1681_COLOR_BLACK, 40, 40, 80, 80, 0);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: gram fill rect failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* update */
+    res = ssd1681_gram_update(&gs_handle, SSD1681_COLOR_BLACK);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: gram update failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* the lut is kept by the refresh */
+    if ((gs_lut_count != 1) || ((gs_sequence & 0x10) != 0))
+    {
+        ssd1681_interface_debug_print("ssd1681: lut is reloaded by the refresh.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* load the full waveform again */
+    res = ssd1681_use_waveform(&gs_handle, SSD1681_WAVEFORM_FULL);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: use waveform failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* check the upload */
+    if (gs_lut_count != 1)
+    {
+        ssd1681_interface_debug_print("ssd1681: lut is uploaded again.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* lut table test */
+    ssd1681_interface_debug_print("ssd1681: lut table test.\n");
+
+    /* set the bands */
+    table[0].temperature_min = -40;
+    table[0].lut = full;
+    table[0].len = full_len;
+    table[1].temperature_min = 20;
+    table[1].lut = fast;
+    table[1].len = fast_len;
+
+    /* set the table */
+    res = ssd1681_set_lut_table(&gs_handle, table, 2);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: set lut table failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* select the full band */
+    res = ssd1681_select_lut(&gs_handle, 10);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: select lut failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* check the upload */
+    if (gs_lut_count != 1)
+    {
+        ssd1681_interface_debug_print("ssd1681: loaded band is uploaded again.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* select the fast band */
+    res = ssd1681_select_lut(&gs_handle, 25);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: select lut failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* check the upload */
+    if (gs_lut_count != 2)
+    {
+        ssd1681_interface_debug_print("ssd1681: band is not uploaded.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* draw a rect */
+    res = ssd1681_gram_fill_rect(&gs_handle, SSD1681_COLOR_BLACK, 60, 60, 100, 100, 1);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: gram fill rect failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* update */
+    res = ssd1681_gram_update(&gs_handle, SSD1681_COLOR_BLACK);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: gram update failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* select the fast band again */
+    res = ssd1681_select_lut(&gs_handle, 25);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: select lut failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* check the upload */
+    if ((gs_lut_count != 2) || ((gs_sequence & 0x10) != 0))
+    {
+        ssd1681_interface_debug_print("ssd1681: band is uploaded again.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* resume test */
+    ssd1681_interface_debug_print("ssd1681: resume test.\n");
+
+    /* enter the deep sleep */
+    res = ssd1681_set_mode(&gs_handle, SSD1681_MODE_DEEP_SLEEP_1);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: set mode failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* resume */
+    res = ssd1681_resume(&gs_handle);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: resume failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* check the replay */
+    if (gs_lut_count != 3)
+    {
+        ssd1681_interface_debug_print("ssd1681: lut is not replayed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* draw a rect */
+    res = ssd1681_gram_fill_rect(&gs_handle, SSD1681_COLOR_BLACK, 80, 80, 120, 120, 0);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: gram fill rect failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* update */
+    res = ssd1681_gram_update(&gs_handle, SSD1681_COLOR_BLACK);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: gram update failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* the replayed lut is kept */
+    if ((gs_lut_count != 3) || ((gs_sequence & 0x10) != 0))
+    {
+        ssd1681_interface_debug_print("ssd1681: replayed lut is reloaded by the refresh.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* clear the black */
+    res = ssd1681_clear(&gs_handle, SSD1681_COLOR_BLACK);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: clear failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* finish lut test */
+    ssd1681_interface_debug_print("ssd1681: finish lut test.\n");
+    (void)ssd1681_deinit(&gs_handle);
+
+    return 0;
+}
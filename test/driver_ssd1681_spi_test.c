@@ -0,0 +1,275 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ssd1681_spi_test.c
+ * @brief     driver ssd1681 spi test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-08-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/08/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ssd1681_spi_test.h"
+
+static ssd1681_handle_t gs_handle;        /**< ssd1681 handle */
+static uint8_t gs_buf[128];               /**< captured bytes */
+static uint16_t gs_len;                   /**< captured length */
+static uint16_t gs_count;                 /**< transfer count */
+
+/**
+ * @brief     spi write with the bytes captured
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the bytes are not sent to the chip
+ */
+static uint8_t a_ssd1681_spi_test_spi_write_cmd(uint8_t *buf, uint16_t len)
+{
+    if (gs_len + len > sizeof(gs_buf))
+    {
+        return 1;
+    }
+    memcpy(&gs_buf[gs_len], buf, len);
+    gs_len += len;
+    gs_count++;
+    
+    return 0;
+}
+
+/**
+ * @brief     check the captured bytes
+ * @param[in] *name pointer to a case name
+ * @param[in] *expect pointer to the expected bytes
+ * @param[in] len expected length
+ * @param[in] count expected transfer count
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the capture is cleared after the check
+ */
+static uint8_t a_ssd1681_spi_test_check(const char *name, const uint8_t *expect, uint16_t len, uint16_t count)
+{
+    uint16_t i;
+    uint8_t res;
+    
+    res = 0;
+    if ((gs_len != len) || (gs_count != count))
+    {
+        ssd1681_interface_debug_print("ssd1681: %s sends %d bytes in %d transfers, expect %d bytes in %d transfers.\n",
+                                      name, gs_len, gs_count, len, count);
+        res = 1;
+    }
+    else
+    {
+        for (i = 0; i < len; i++)
+        {
+            if (gs_buf[i] != expect[i])
+            {
+                ssd1681_interface_debug_print("ssd1681: %s byte %d is 0x%02X, expect 0x%02X.\n",
+                                              name, i, gs_buf[i], expect[i]);
+                res = 1;
+                
+                break;
+            }
+        }
+    }
+    if (res == 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: %s check passed.\n", name);
+    }
+    gs_len = 0;
+    gs_count = 0;
+    
+    return res;
+}
+
+/**
+ * @brief  spi test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the packed 3-wire frames are captured and not sent to the chip
+ */
+uint8_t ssd1681_spi_test(void)
+{
+    uint8_t res;
+    uint8_t cmd;
+    uint8_t data[66];
+    uint8_t expect[75];
+    ssd1681_info_t info;
+    
+    /* link functions */
+    DRIVER_SSD1681_LINK_INIT(&gs_handle, ssd1681_handle_t);
+    DRIVER_SSD1681_LINK_SPI_INIT(&gs_handle, ssd1681_interface_spi_init);
+    DRIVER_SSD1681_LINK_SPI_DEINIT(&gs_handle, ssd1681_interface_spi_deinit);
+    DRIVER_SSD1681_LINK_SPI_WRITE_CMD(&gs_handle, a_ssd1681_spi_test_spi_write_cmd);
+    DRIVER_SSD1681_LINK_SPI_READ_CMD(&gs_handle, ssd1681_interface_spi_read_cmd);
+    DRIVER_SSD1681_LINK_SPI_CMD_DATA_GPIO_INIT(&gs_handle, ssd1681_interface_spi_cmd_data_gpio_init);
+    DRIVER_SSD1681_LINK_SPI_CMD_DATA_GPIO_DEINIT(&gs_handle, ssd1681_interface_spi_cmd_data_gpio_deinit);
+    DRIVER_SSD1681_LINK_SPI_CMD_DATA_GPIO_WRITE(&gs_handle, ssd1681_interface_spi_cmd_data_gpio_write);
+    DRIVER_SSD1681_LINK_RESET_GPIO_INIT(&gs_handle, ssd1681_interface_reset_gpio_init);
+    DRIVER_SSD1681_LINK_RESET_GPIO_DEINIT(&gs_handle, ssd1681_interface_reset_gpio_deinit);
+    DRIVER_SSD1681_LINK_RESET_GPIO_WRITE(&gs_handle, ssd1681_interface_reset_gpio_write);
+    DRIVER_SSD1681_LINK_BUSY_GPIO_INIT(&gs_handle, ssd1681_interface_busy_gpio_init);
+    DRIVER_SSD1681_LINK_BUSY_GPIO_DEINIT(&gs_handle, ssd1681_interface_busy_gpio_deinit);
+    DRIVER_SSD1681_LINK_BUSY_GPIO_READ(&gs_handle, ssd1681_interface_busy_gpio_read);
+    DRIVER_SSD1681_LINK_DELAY_MS(&gs_handle, ssd1681_interface_delay_ms);
+    DRIVER_SSD1681_LINK_DEBUG_PRINT(&gs_handle, ssd1681_interface_debug_print);
+    
+    /* ssd1681 info */
+    res = ssd1681_info(&info);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: get info failed.\n");
+        
+        return 1;
+    }
+    else
+    {
+        /* print chip information */
+        ssd1681_interface_debug_print("ssd1681: chip is %s.\n", info.chip_name);
+        ssd1681_interface_debug_print("ssd1681: manufacturer is %s.\n", info.manufacturer_name);
+        ssd1681_interface_debug_print("ssd1681: interface is %s.\n", info.interface);
+        ssd1681_interface_debug_print("ssd1681: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        ssd1681_interface_debug_print("ssd1681: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        ssd1681_interface_debug_print("ssd1681: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        ssd1681_interface_debug_print("ssd1681: max current is %0.2fmA.\n", info.max_current_ma);
+        ssd1681_interface_debug_print("ssd1681: max temperature is %0.1fC.\n", info.temperature_max);
+        ssd1681_interface_debug_print("ssd1681: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start spi test */
+    ssd1681_interface_debug_print("ssd1681: start spi test.\n");
+    
+    /* pack the 9-bit frames */
+    res = ssd1681_set_interface(&gs_handle, SSD1681_INTERFACE_3_WIRE);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: set interface failed.\n");
+        
+        return 1;
+    }
+    
+    /* init */
+    res = ssd1681_init(&gs_handle);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: init failed.\n");
+        
+        return 1;
+    }
+    gs_len = 0;
+    gs_count = 0;
+    
+    /* one command frame, 9 bits padded with 7 zero bits */
+    cmd = 0x3C;
+    res = ssd1681_write_cmd(&gs_handle, &cmd, 1);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: write cmd failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+        
+        return 1;
+    }
+    expect[0] = 0x1E;
+    expect[1] = 0x00;
+    if (a_ssd1681_spi_test_check("1 command frame", expect, 2, 1) != 0)
+    {
+        (void)ssd1681_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* three data frames, 27 bits padded with 5 zero bits */
+    data[0] = 0xA5;
+    data[1] = 0x3C;
+    data[2] = 0xFF;
+    res = ssd1681_write_data(&gs_handle, data, 3);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: write data failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+        
+        return 1;
+    }
+    expect[0] = 0xD2;
+    expect[1] = 0xCF;
+    expect[2] = 0x3F;
+    expect[3] = 0xE0;
+    if (a_ssd1681_spi_test_check("3 data frames", expect, 4, 1) != 0)
+    {
+        (void)ssd1681_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* eight data frames, 72 bits without padding */
+    memset(data, 0xFF, 8);
+    res = ssd1681_write_data(&gs_handle, data, 8);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: write data failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+        
+        return 1;
+    }
+    memset(expect, 0xFF, 9);
+    if (a_ssd1681_spi_test_check("8 data frames", expect, 9, 1) != 0)
+    {
+        (void)ssd1681_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* 66 data frames, 64 frames in the first transfer and 18 bits padded with 6 zero bits */
+    memset(data, 0xFF, 66);
+    res = ssd1681_write_data(&gs_handle, data, 66);
+    if (res != 0)
+    {
+        ssd1681_interface_debug_print("ssd1681: write data failed.\n");
+        (void)ssd1681_deinit(&gs_handle);
+        
+        return 1;
+    }
+    memset(expect, 0xFF, 74);
+    expect[74] = 0xC0;
+    if (a_ssd1681_spi_test_check("66 data frames", expect, 75, 2) != 0)
+    {
+        (void)ssd1681_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish spi test */
+    ssd1681_interface_debug_print("ssd1681: finish spi test.\n");
+    (void)ssd1681_deinit(&gs_handle);
+    
+    return 0;
+}